@@ -57,3 +57,49 @@ int32 UAnimSequenceRuntime::AddNewRawTrackRuntime(FName TrackName, FRawAnimSeque
 	return TrackIndex;
 #endif
 }
+
+void UAnimSequenceRuntime::AddNewRawTracksRuntime(TConstArrayView<FName> TrackNames, TConstArrayView<int32> SkeletonBoneIndices, TArray<int32>& OutTrackIndices)
+{
+	check(TrackNames.Num() == SkeletonBoneIndices.Num());
+	OutTrackIndices.SetNumUninitialized(TrackNames.Num());
+
+#if WITH_EDITORONLY_DATA
+	for (int32 I = 0; I < TrackNames.Num(); I += 1)
+	{
+		OutTrackIndices[I] = AddNewRawTrack(TrackNames[I], nullptr);
+	}
+#else
+	auto& RawAnimationData = const_cast<TArray<FRawAnimSequenceTrack>&>(GetRawAnimationData());
+	auto& TrackToSkeletonMapTable = const_cast<TArray<FTrackToSkeletonMap>&>(GetRawTrackToSkeletonMapTable());
+	// During compression, we store the track indices on 16 bits
+	constexpr int32 MAX_NUM_TRACKS = 65535;
+
+	RawAnimationData.Reserve(RawAnimationData.Num() + TrackNames.Num());
+	TrackToSkeletonMapTable.Reserve(TrackToSkeletonMapTable.Num() + TrackNames.Num());
+
+	// The tracks added by this call, to find the repeated names without
+	// searching all the tracks each time.
+	TMap<FName, int32> AddedTracks;
+	AddedTracks.Reserve(TrackNames.Num());
+
+	for (int32 I = 0; I < TrackNames.Num(); I += 1)
+	{
+		if (const int32* TrackIndex = AddedTracks.Find(TrackNames[I]))
+		{
+			OutTrackIndices[I] = *TrackIndex;
+			continue;
+		}
+
+		if (SkeletonBoneIndices[I] == INDEX_NONE || RawAnimationData.Num() >= MAX_NUM_TRACKS)
+		{
+			OutTrackIndices[I] = INDEX_NONE;
+			continue;
+		}
+
+		const int32 TrackIndex = RawAnimationData.Add(FRawAnimSequenceTrack());
+		TrackToSkeletonMapTable.Add(FTrackToSkeletonMap(SkeletonBoneIndices[I]));
+		AddedTracks.Add(TrackNames[I], TrackIndex);
+		OutTrackIndices[I] = TrackIndex;
+	}
+#endif
+}
@@ -27,4 +27,10 @@ public:
 	/// If called on editor, it creates enough data to store this Animation.
 	/// If called at runtime it still creates the animation.
 	int32 AddNewRawTrackRuntime(FName TrackName, FRawAnimSequenceTrack* TrackData, TArray<FName>& RuntimeAnimationTrackNames);
+
+	/// Adds an empty track for each of `TrackNames`, whose skeleton bones are
+	/// already resolved in `SkeletonBoneIndices`. The names repeated in
+	/// `TrackNames` share the same track, the others must not have a track yet.
+	/// `OutTrackIndices` is `INDEX_NONE` for the tracks that can't be added.
+	void AddNewRawTracksRuntime(TConstArrayView<FName> TrackNames, TConstArrayView<int32> SkeletonBoneIndices, TArray<int32>& OutTrackIndices);
 };
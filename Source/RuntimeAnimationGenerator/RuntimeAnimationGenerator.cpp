@@ -15,6 +15,10 @@
 #include "AnimSequenceRuntime.h"
 #include "AnimationUtils.h"
 #include "Animation/AnimSequenceBase.h"
+#include "Async/ParallelFor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include <atomic>
 
 void FRuntimeAnimationGeneratorModule::StartupModule()
 {
@@ -35,37 +39,590 @@ FRuntimeAnimationGenerator::FKeyFrame::FKeyFrame(const double Time, const FVecto
 
 IMPLEMENT_MODULE(FRuntimeAnimationGeneratorModule, RuntimeAnimationGenerator)
 
-void FRuntimeAnimationGenerator::PrepareSkeletonTracks(const USkeleton* Skeleton, FTracks& OutTracks)
+DECLARE_STATS_GROUP(TEXT("RuntimeAnimationGenerator"), STATGROUP_RuntimeAnimationGenerator, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Prepare"), STAT_RuntimeAnimation_Prepare, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_CYCLE_STAT(TEXT("Reduce"), STAT_RuntimeAnimation_Reduce, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_CYCLE_STAT(TEXT("Timing"), STAT_RuntimeAnimation_Timing, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_CYCLE_STAT(TEXT("FillTracks"), STAT_RuntimeAnimation_FillTracks, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_CYCLE_STAT(TEXT("Finalize"), STAT_RuntimeAnimation_Finalize, STATGROUP_RuntimeAnimationGenerator);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracks"), STAT_RuntimeAnimation_Tracks, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Source Keys"), STAT_RuntimeAnimation_SourceKeys, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Removed Keys"), STAT_RuntimeAnimation_RemovedKeys, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frames"), STAT_RuntimeAnimation_Frames, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Constant Channels"), STAT_RuntimeAnimation_ConstantChannels, STATGROUP_RuntimeAnimationGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Allocated Bytes"), STAT_RuntimeAnimation_AllocatedBytes, STATGROUP_RuntimeAnimationGenerator);
+
+namespace
 {
-	OutTracks.IsReady = false;
+	/// The data returned by `FRuntimeAnimationGenerator::GetStats`; it's atomic
+	/// since the tracks can be prepared from any thread.
+	struct FAtomicGeneratorStats
+	{
+		std::atomic<int64> PreparedTracks{0};
+		std::atomic<int64> GeneratedSequences{0};
+
+		std::atomic<uint64> PrepareCycles{0};
+		std::atomic<uint64> ReduceCycles{0};
+		std::atomic<uint64> TimingCycles{0};
+		std::atomic<uint64> FillTracksCycles{0};
+		std::atomic<uint64> FinalizeCycles{0};
+
+		std::atomic<int64> Tracks{0};
+		std::atomic<int64> SourceKeys{0};
+		std::atomic<int64> RemovedKeys{0};
+		std::atomic<int64> Frames{0};
+		std::atomic<int64> ConstantChannels{0};
+		std::atomic<int64> AllocatedBytes{0};
+	};
+
+	FAtomicGeneratorStats GeneratorStats;
+
+	/// Adds the cycles spent in the scope to `Cycles`.
+	struct FScopedPhaseCycles
+	{
+		std::atomic<uint64>& Cycles;
+		const uint64 StartCycles;
+
+		explicit FScopedPhaseCycles(std::atomic<uint64>& InCycles)
+			: Cycles(InCycles)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+		}
+
+		~FScopedPhaseCycles()
+		{
+			Cycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+	};
+}
+
+/// Measures a generation phase, which is then visible with
+/// `stat RuntimeAnimationGenerator`, in Unreal Insights and in
+/// `FRuntimeAnimationGenerator::GetStats`.
+#define RUNTIME_ANIMATION_PHASE(Phase) \
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeAnimation_##Phase); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(RuntimeAnimation_##Phase); \
+	const FScopedPhaseCycles ANONYMOUS_VARIABLE(PhaseCycles)(GeneratorStats.Phase##Cycles)
+
+namespace
+{
+	using FKeyFrame = FRuntimeAnimationGenerator::FKeyFrame;
+	using FTrack = FRuntimeAnimationGenerator::FTrack;
+
+	/// The channels of a key frame, each reduced and sampled on its own.
+	constexpr int32 PositionChannel = 0;
+	constexpr int32 RotationChannel = 1;
+	constexpr int32 ScaleChannel = 2;
+	constexpr int32 ChannelsNum = 3;
 
-	// Delete the empty tracks and wrong BoneName.
-	for (int32 I = OutTracks.Tracks.Num() - 1; I >= 0; I -= 1)
+	/// Interpolates only the `Channel` of the key frames: the other channels
+	/// are the ones of `Frame1`.
+	FKeyFrame InterpolateChannel(const FKeyFrame& Frame1, const FKeyFrame& Frame2, const double Time, const double Alpha, const int32 Channel)
 	{
-		const FName& BoneName = OutTracks.Tracks[I].BoneName;
-		if (OutTracks.Tracks[I].KeyFrames.Num() == 0 ||
-		    Skeleton->GetReferenceSkeleton().FindBoneIndex(BoneName) == INDEX_NONE)
+		FKeyFrame Frame(Time, Frame1.Position, Frame1.Rotation, Frame1.Scale);
+		switch (Channel)
 		{
-			OutTracks.Tracks.RemoveAt(I);
+		case PositionChannel:
+			Frame.Position = FMath::Lerp(Frame1.Position, Frame2.Position, Alpha);
+			break;
+		case RotationChannel:
+			Frame.Rotation = FQuat::Slerp(Frame1.Rotation, Frame2.Rotation, Alpha);
+			break;
+		default:
+			Frame.Scale = FMath::Lerp(Frame1.Scale, Frame2.Scale, Alpha);
+			break;
+		}
+		return Frame;
+	}
+
+	bool IsPositionWithinError(const FVector& A, const FVector& B, const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		return FVector::Dist(A, B) <= Sampling.MaxPositionError;
+	}
+
+	bool IsRotationWithinError(const FQuat& A, const FQuat& B, const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		return A.AngularDistance(B) <= Sampling.MaxRotationError;
+	}
+
+	bool IsScaleWithinError(const FVector& A, const FVector& B, const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		return A.Equals(B, Sampling.MaxScaleError);
+	}
+
+	bool IsChannelWithinError(const FKeyFrame& A, const FKeyFrame& B, const int32 Channel, const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		switch (Channel)
+		{
+		case PositionChannel:
+			return IsPositionWithinError(A.Position, B.Position, Sampling);
+		case RotationChannel:
+			return IsRotationWithinError(A.Rotation, B.Rotation, Sampling);
+		default:
+			return IsScaleWithinError(A.Scale, B.Scale, Sampling);
+		}
+	}
+
+	/// The key frames kept for each channel of a track by the reduction, as
+	/// indices in its `KeyFrames`. A constant channel keeps only its first key
+	/// frame.
+	struct FReducedTrack
+	{
+		TArray<int32> KeyIndices[ChannelsNum];
+	};
+
+	/// The key frames of a channel of a track: all of them, or the ones kept by
+	/// the reduction.
+	struct FChannelKeys
+	{
+		const FKeyFrame* KeyFrames = nullptr;
+		/// Null when all the key frames are used.
+		const int32* KeyIndices = nullptr;
+		int32 KeysNum = 0;
+
+		FChannelKeys(const FTrack& Track, const FReducedTrack* ReducedTrack, const int32 Channel)
+			: KeyFrames(Track.KeyFrames.GetData())
+			, KeyIndices(ReducedTrack ? ReducedTrack->KeyIndices[Channel].GetData() : nullptr)
+			, KeysNum(ReducedTrack ? ReducedTrack->KeyIndices[Channel].Num() : Track.KeyFrames.Num())
+		{
+		}
+
+		int32 Num() const
+		{
+			return KeysNum;
+		}
+
+		const FKeyFrame& operator[](const int32 I) const
+		{
+			return KeyIndices ? KeyFrames[KeyIndices[I]] : KeyFrames[I];
+		}
+	};
+
+	/// Evaluates the `Channel` at `Time`, interpolating the two key frames
+	/// around it. `InOutKeyIndex` is the key frame found by the previous call:
+	/// the `Time` must not decrease between the calls, so the keys are walked
+	/// once.
+	FKeyFrame EvaluateChannel(const FChannelKeys& Keys, const double Time, const int32 Channel, int32& InOutKeyIndex)
+	{
+		while (InOutKeyIndex + 1 < Keys.Num() && Time >= Keys[InOutKeyIndex + 1].Time)
+		{
+			InOutKeyIndex += 1;
+		}
+
+		const FKeyFrame& Frame1 = Keys[InOutKeyIndex];
+		if (InOutKeyIndex + 1 >= Keys.Num())
+		{
+			// This is the last frame, nothing to interpolate.
+			return FKeyFrame(Time, Frame1.Position, Frame1.Rotation, Frame1.Scale);
+		}
+
+		const FKeyFrame& Frame2 = Keys[InOutKeyIndex + 1];
+		checkf(Frame1.Time < Frame2.Time, TEXT("This is is impossible because the `Prepare` clears all the duplicate key frames."));
+		const double Alpha = FMath::Clamp((Time - Frame1.Time) / (Frame2.Time - Frame1.Time), 0.0, 1.0);
+		return InterpolateChannel(Frame1, Frame2, Time, Alpha, Channel);
+	}
+
+	/// True when sampling the tracks every `FrameInterval` seconds reproduces
+	/// all their key frames within the `Sampling` error bounds.
+	/// `ReducedTracks` is empty when the tracks were not reduced; otherwise the
+	/// frames are evaluated from the kept key frames, but still compared with
+	/// all the source ones, so the reduction and the sampling errors don't add
+	/// up.
+	bool IsWithinErrorBounds(
+		const TArray<FTrack>& Tracks,
+		TConstArrayView<FReducedTrack> ReducedTracks,
+		const double FrameInterval,
+		const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
+		{
+			for (int32 Channel = 0; Channel < ChannelsNum; Channel += 1)
+			{
+				const FChannelKeys Keys(Tracks[TrackId], ReducedTracks.Num() > 0 ? &ReducedTracks[TrackId] : nullptr, Channel);
+
+				// The frames before and after each key are evaluated with their
+				// own cursor, since both advance monotonically.
+				int32 PreviousFrameKey = 0;
+				int32 NextFrameKey = 0;
+				for (const FKeyFrame& Key : Tracks[TrackId].KeyFrames)
+				{
+					const double FrameIndex = FMath::FloorToDouble(Key.Time / FrameInterval);
+					const FKeyFrame PreviousFrame = EvaluateChannel(Keys, FrameIndex * FrameInterval, Channel, PreviousFrameKey);
+					const FKeyFrame NextFrame = EvaluateChannel(Keys, (FrameIndex + 1.0) * FrameInterval, Channel, NextFrameKey);
+					const double Alpha = FMath::Clamp(Key.Time / FrameInterval - FrameIndex, 0.0, 1.0);
+
+					if (!IsChannelWithinError(InterpolateChannel(PreviousFrame, NextFrame, Key.Time, Alpha, Channel), Key, Channel, Sampling))
+					{
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	/// True when the `Channel` of all the key frames keeps the value of the
+	/// first one, within the error bounds.
+	bool IsChannelConstant(const TArray<FKeyFrame>& KeyFrames, const int32 Channel, const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		for (int32 I = 1; I < KeyFrames.Num(); I += 1)
+		{
+			if (!IsChannelWithinError(KeyFrames[0], KeyFrames[I], Channel, Sampling))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// True when interpolating the `Channel` of the key frames `Begin` and `End`
+	/// rebuilds the one of all the key frames between them within the error
+	/// bounds.
+	bool CanInterpolateKeyFrames(
+		const TArray<FKeyFrame>& KeyFrames,
+		const int32 Begin,
+		const int32 End,
+		const int32 Channel,
+		const FRuntimeAnimationGenerator::FSampling& Sampling)
+	{
+		const FKeyFrame& Frame1 = KeyFrames[Begin];
+		const FKeyFrame& Frame2 = KeyFrames[End];
+		for (int32 I = Begin + 1; I < End; I += 1)
+		{
+			const double Alpha = (KeyFrames[I].Time - Frame1.Time) / (Frame2.Time - Frame1.Time);
+			if (!IsChannelWithinError(InterpolateChannel(Frame1, Frame2, KeyFrames[I].Time, Alpha, Channel), KeyFrames[I], Channel, Sampling))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// The max key frames between two kept ones: each key frame is checked at
+	/// most this many times, so the reduction takes linear time. A channel that
+	/// a single segment rebuilds for longer keeps a key frame every
+	/// `MaxRemovedRun`.
+	constexpr int32 MaxRemovedRun = 32;
+
+	/// Finds the key frames of the `Channel` that the interpolation of the kept
+	/// ones around them doesn't rebuild within the error bounds. The constant
+	/// channels are detected first and keep only the first key frame; the
+	/// others keep the first and the last ones too. Returns the amount of
+	/// removed key frames.
+	int32 ReduceChannel(
+		const TArray<FKeyFrame>& KeyFrames,
+		const int32 Channel,
+		const FRuntimeAnimationGenerator::FSampling& Sampling,
+		TArray<int32>& OutKeyIndices)
+	{
+		const int32 KeyFramesNum = KeyFrames.Num();
+		OutKeyIndices.Reset();
+		OutKeyIndices.Add(0);
+		if (IsChannelConstant(KeyFrames, Channel, Sampling))
+		{
+			return KeyFramesNum - 1;
+		}
+
+		int32 Anchor = 0;
+		for (int32 End = 2; End < KeyFramesNum; End += 1)
+		{
+			if (End - Anchor > MaxRemovedRun || !CanInterpolateKeyFrames(KeyFrames, Anchor, End, Channel, Sampling))
+			{
+				Anchor = End - 1;
+				OutKeyIndices.Add(Anchor);
+			}
+		}
+		OutKeyIndices.Add(KeyFramesNum - 1);
+		return KeyFramesNum - OutKeyIndices.Num();
+	}
+
+	/// Lerps `Start` and `End` into `FramesNum` consecutive vectors, the first
+	/// at `Alpha` and the others `AlphaStep` apart. Four vectors are 12
+	/// contiguous floats, three registers: each iteration computes four frames
+	/// at once, with the components of `Start`, `End` and the alphas laid out
+	/// as the registers store them, so nothing is transposed.
+	void LerpVectors(
+		const FVector3f& Start,
+		const FVector3f& End,
+		const double Alpha,
+		const double AlphaStep,
+		const int32 FramesNum,
+		FVector3f* OutVectors)
+	{
+		const FVector3f Delta = End - Start;
+		const VectorRegister4Float Start0 = MakeVectorRegisterFloat(Start.X, Start.Y, Start.Z, Start.X);
+		const VectorRegister4Float Start1 = MakeVectorRegisterFloat(Start.Y, Start.Z, Start.X, Start.Y);
+		const VectorRegister4Float Start2 = MakeVectorRegisterFloat(Start.Z, Start.X, Start.Y, Start.Z);
+		const VectorRegister4Float Delta0 = MakeVectorRegisterFloat(Delta.X, Delta.Y, Delta.Z, Delta.X);
+		const VectorRegister4Float Delta1 = MakeVectorRegisterFloat(Delta.Y, Delta.Z, Delta.X, Delta.Y);
+		const VectorRegister4Float Delta2 = MakeVectorRegisterFloat(Delta.Z, Delta.X, Delta.Y, Delta.Z);
+		// The frame of each component, from the first of the iteration.
+		const VectorRegister4Float Frames0 = MakeVectorRegisterFloat(0.0f, 0.0f, 0.0f, 1.0f);
+		const VectorRegister4Float Frames1 = MakeVectorRegisterFloat(1.0f, 1.0f, 2.0f, 2.0f);
+		const VectorRegister4Float Frames2 = MakeVectorRegisterFloat(2.0f, 3.0f, 3.0f, 3.0f);
+		const VectorRegister4Float Step = VectorSetFloat1(static_cast<float>(AlphaStep));
+
+		int32 I = 0;
+		for (; I + 4 <= FramesNum; I += 4)
+		{
+			// The base alpha is computed in double for each iteration, so the
+			// error doesn't accumulate along the segment.
+			const VectorRegister4Float BaseAlpha = VectorSetFloat1(static_cast<float>(Alpha + AlphaStep * I));
+			float* Data = &OutVectors[I].X;
+			VectorStore(VectorMultiplyAdd(Delta0, VectorMultiplyAdd(Frames0, Step, BaseAlpha), Start0), Data);
+			VectorStore(VectorMultiplyAdd(Delta1, VectorMultiplyAdd(Frames1, Step, BaseAlpha), Start1), Data + 4);
+			VectorStore(VectorMultiplyAdd(Delta2, VectorMultiplyAdd(Frames2, Step, BaseAlpha), Start2), Data + 8);
+		}
+
+		const VectorRegister4Float StartVector = VectorLoadFloat3(&Start.X);
+		const VectorRegister4Float DeltaVector = VectorLoadFloat3(&Delta.X);
+		for (; I < FramesNum; I += 1)
+		{
+			const VectorRegister4Float FrameAlpha = VectorSetFloat1(static_cast<float>(Alpha + AlphaStep * I));
+			VectorStoreFloat3(VectorMultiplyAdd(DeltaVector, FrameAlpha, StartVector), &OutVectors[I].X);
+		}
+	}
+
+	/// Interpolates `Frame1` and `Frame2` into `FramesNum` consecutive frames,
+	/// the first at `Alpha` and the others `AlphaStep` apart. The blend factors
+	/// of the segment are computed once, and the frames are computed four at a
+	/// time: a lerp for the positions and scales, a nlerp or a slerp for the
+	/// rotations. The null outputs are skipped.
+	void InterpolateSegment(
+		const FKeyFrame& Frame1,
+		const FKeyFrame& Frame2,
+		const double Alpha,
+		const double AlphaStep,
+		const int32 FramesNum,
+		FVector3f* OutPositions,
+		FQuat4f* OutRotations,
+		FVector3f* OutScales)
+	{
+		if (OutPositions)
+		{
+			LerpVectors(FVector3f(Frame1.Position), FVector3f(Frame2.Position), Alpha, AlphaStep, FramesNum, OutPositions);
+		}
+
+		if (OutScales)
+		{
+			LerpVectors(FVector3f(Frame1.Scale), FVector3f(Frame2.Scale), Alpha, AlphaStep, FramesNum, OutScales);
+		}
+
+		if (OutRotations)
+		{
+			const FQuat4f Rotation1(Frame1.Rotation);
+			FQuat4f Rotation2(Frame2.Rotation);
+			// Take the shortest path, as `FQuat::Slerp` does.
+			float Cos = Rotation1 | Rotation2;
+			if (Cos < 0.0f)
+			{
+				Rotation2 = FQuat4f(-Rotation2.X, -Rotation2.Y, -Rotation2.Z, -Rotation2.W);
+				Cos = -Cos;
+			}
+			const VectorRegister4Float Start = VectorLoad(&Rotation1.X);
+			const VectorRegister4Float End = VectorLoad(&Rotation2.X);
+
+			// Each quaternion is a register: the alphas of four frames are the
+			// components of a register, replicated for each frame.
+			const VectorRegister4Float Frames = MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f);
+			const VectorRegister4Float Step = VectorSetFloat1(static_cast<float>(AlphaStep));
+			const int32 VectorFramesNum = FramesNum - FramesNum % 4;
+
+			if (Cos >= 0.9999f)
+			{
+				// The rotations are almost the same: the normalized lerp matches
+				// the slerp, without the trigonometry.
+				const VectorRegister4Float Delta = VectorSubtract(End, Start);
+				for (int32 I = 0; I < VectorFramesNum; I += 4)
+				{
+					const VectorRegister4Float Alphas = VectorMultiplyAdd(Frames, Step, VectorSetFloat1(static_cast<float>(Alpha + AlphaStep * I)));
+					VectorStore(VectorNormalizeQuaternion(VectorMultiplyAdd(Delta, VectorReplicate(Alphas, 0), Start)), &OutRotations[I].X);
+					VectorStore(VectorNormalizeQuaternion(VectorMultiplyAdd(Delta, VectorReplicate(Alphas, 1), Start)), &OutRotations[I + 1].X);
+					VectorStore(VectorNormalizeQuaternion(VectorMultiplyAdd(Delta, VectorReplicate(Alphas, 2), Start)), &OutRotations[I + 2].X);
+					VectorStore(VectorNormalizeQuaternion(VectorMultiplyAdd(Delta, VectorReplicate(Alphas, 3), Start)), &OutRotations[I + 3].X);
+				}
+				for (int32 I = VectorFramesNum; I < FramesNum; I += 1)
+				{
+					const VectorRegister4Float FrameAlpha = VectorSetFloat1(static_cast<float>(Alpha + AlphaStep * I));
+					VectorStore(VectorNormalizeQuaternion(VectorMultiplyAdd(Delta, FrameAlpha, Start)), &OutRotations[I].X);
+				}
+			}
+			else
+			{
+				// The weights of four frames take two vector sines.
+				const float Omega = FMath::Acos(Cos);
+				const VectorRegister4Float OmegaVector = VectorSetFloat1(Omega);
+				const float InvSin = 1.0f / FMath::Sin(Omega);
+				const VectorRegister4Float InvSinVector = VectorSetFloat1(InvSin);
+				for (int32 I = 0; I < VectorFramesNum; I += 4)
+				{
+					const VectorRegister4Float Alphas = VectorMultiplyAdd(Frames, Step, VectorSetFloat1(static_cast<float>(Alpha + AlphaStep * I)));
+					const VectorRegister4Float Scales1 = VectorMultiply(VectorSin(VectorMultiply(VectorSubtract(VectorOne(), Alphas), OmegaVector)), InvSinVector);
+					const VectorRegister4Float Scales2 = VectorMultiply(VectorSin(VectorMultiply(Alphas, OmegaVector)), InvSinVector);
+					VectorStore(VectorMultiplyAdd(End, VectorReplicate(Scales2, 0), VectorMultiply(Start, VectorReplicate(Scales1, 0))), &OutRotations[I].X);
+					VectorStore(VectorMultiplyAdd(End, VectorReplicate(Scales2, 1), VectorMultiply(Start, VectorReplicate(Scales1, 1))), &OutRotations[I + 1].X);
+					VectorStore(VectorMultiplyAdd(End, VectorReplicate(Scales2, 2), VectorMultiply(Start, VectorReplicate(Scales1, 2))), &OutRotations[I + 2].X);
+					VectorStore(VectorMultiplyAdd(End, VectorReplicate(Scales2, 3), VectorMultiply(Start, VectorReplicate(Scales1, 3))), &OutRotations[I + 3].X);
+				}
+				for (int32 I = VectorFramesNum; I < FramesNum; I += 1)
+				{
+					const float FrameAlpha = static_cast<float>(Alpha + AlphaStep * I);
+					const VectorRegister4Float Scale1 = VectorSetFloat1(FMath::Sin((1.0f - FrameAlpha) * Omega) * InvSin);
+					const VectorRegister4Float Scale2 = VectorSetFloat1(FMath::Sin(FrameAlpha * Omega) * InvSin);
+					VectorStore(VectorMultiplyAdd(End, Scale2, VectorMultiply(Start, Scale1)), &OutRotations[I].X);
+				}
+			}
+		}
+	}
+
+	/// Samples the keys every `FrameInterval` seconds into the first
+	/// `FramesNum` frames of the non null outputs. The frames between the same
+	/// two key frames are interpolated together, by `InterpolateSegment`.
+	void SampleKeys(
+		const FChannelKeys& KeyFrames,
+		const double FrameInterval,
+		const uint32 FramesNum,
+		FVector3f* OutPositions,
+		FQuat4f* OutRotations,
+		FVector3f* OutScales)
+	{
+		uint32 FrameIndex = 0;
+		int32 KeyIndex = 0;
+		while (FrameIndex < FramesNum)
+		{
+			const double Time = FrameInterval * static_cast<double>(FrameIndex);
+			while (KeyIndex + 1 < KeyFrames.Num() && Time >= KeyFrames[KeyIndex + 1].Time)
+			{
+				KeyIndex += 1;
+			}
+
+			// After the last key frame, it's held until the end.
+			const bool bLastKeyFrame = KeyIndex + 1 >= KeyFrames.Num();
+			const FKeyFrame& Frame1 = KeyFrames[KeyIndex];
+			const FKeyFrame& Frame2 = bLastKeyFrame ? Frame1 : KeyFrames[KeyIndex + 1];
+
+			uint32 SegmentEnd = FramesNum;
+			double Alpha = 0.0;
+			double AlphaStep = 0.0;
+			if (!bLastKeyFrame)
+			{
+				// The frames before the next key frame.
+				SegmentEnd = FrameIndex + 1;
+				while (SegmentEnd < FramesNum && FrameInterval * static_cast<double>(SegmentEnd) < Frame2.Time)
+				{
+					SegmentEnd += 1;
+				}
+				const double SegmentDuration = Frame2.Time - Frame1.Time;
+				Alpha = (Time - Frame1.Time) / SegmentDuration;
+				AlphaStep = FrameInterval / SegmentDuration;
+			}
+
+			InterpolateSegment(
+				Frame1,
+				Frame2,
+				Alpha,
+				AlphaStep,
+				SegmentEnd - FrameIndex,
+				OutPositions ? OutPositions + FrameIndex : nullptr,
+				OutRotations ? OutRotations + FrameIndex : nullptr,
+				OutScales ? OutScales + FrameIndex : nullptr);
+
+			FrameIndex = SegmentEnd;
 		}
 	}
 
-	// Delete duplicate KeyFrames
-	for (int32 I = OutTracks.Tracks.Num() - 1; I >= 0; I -= 1)
+	/// Returns the interval between the frames of the generated sequence.
+	double ComputeFrameInterval(
+		const TArray<FTrack>& Tracks,
+		TConstArrayView<FReducedTrack> ReducedTracks,
+		const FRuntimeAnimationGenerator::FSampling& Sampling,
+		const double MinKeyInterval,
+		const double SequenceDuration)
 	{
-		for (int32 Y = OutTracks.Tracks[I].KeyFrames.Num() - 1; Y > 0; Y -= 1)
+		if (Sampling.Mode == FRuntimeAnimationGenerator::ESamplingMode::MinKeyInterval ||
+		    Sampling.SampleRate <= 0.0 ||
+		    SequenceDuration <= 0.0)
+		{
+			return MinKeyInterval;
+		}
+
+		if (Sampling.Mode == FRuntimeAnimationGenerator::ESamplingMode::FixedRate)
+		{
+			return 1.0 / Sampling.SampleRate;
+		}
+
+		// Sampling faster than the closest keys doesn't reduce the error.
+		const double MaxRate = FMath::Min(Sampling.SampleRate, 1.0 / MinKeyInterval);
+
+		// Start from the key rate of the densest channel, then double it until
+		// the error is within bounds.
+		double Rate = 0.0;
+		for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
 		{
-			if (OutTracks.Tracks[I].KeyFrames[Y].Time == OutTracks.Tracks[I].KeyFrames[Y - 1].Time)
+			for (int32 Channel = 0; Channel < ChannelsNum; Channel += 1)
 			{
-				OutTracks.Tracks[I].KeyFrames.RemoveAt(Y);
+				const FChannelKeys Keys(Tracks[TrackId], ReducedTracks.Num() > 0 ? &ReducedTracks[TrackId] : nullptr, Channel);
+				Rate = FMath::Max(Rate, (Keys.Num() - 1) / SequenceDuration);
 			}
 		}
+		Rate = FMath::Clamp(Rate, 1.0 / SequenceDuration, MaxRate);
+
+		while (Rate < MaxRate && !IsWithinErrorBounds(Tracks, ReducedTracks, 1.0 / Rate, Sampling))
+		{
+			Rate = FMath::Min(Rate * 2.0, MaxRate);
+		}
+		return 1.0 / Rate;
 	}
+}
 
-	// Sort the tracks.
+void FRuntimeAnimationGenerator::PrepareSkeletonTracks(const USkeleton* Skeleton, FTracks& OutTracks)
+{
+	RUNTIME_ANIMATION_PHASE(Prepare);
+	GeneratorStats.PreparedTracks += 1;
+
+	OutTracks.IsReady = false;
+
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+
+	// Resolve the bones: the indices already set are only checked.
 	for (FTrack& Track : OutTracks.Tracks)
 	{
-		Track.KeyFrames.Sort();
+		if (!RefSkeleton.IsValidIndex(Track.BoneIndex) || RefSkeleton.GetBoneName(Track.BoneIndex) != Track.BoneName)
+		{
+			Track.BoneIndex = RefSkeleton.FindBoneIndex(Track.BoneName);
+		}
+	}
+
+	// Delete the empty tracks and wrong BoneName, in a single pass.
+	OutTracks.Tracks.RemoveAll([](const FTrack& Track)
+	{
+		return Track.KeyFrames.Num() == 0 || Track.BoneIndex == INDEX_NONE;
+	});
+
+	for (FTrack& Track : OutTracks.Tracks)
+	{
+		TArray<FKeyFrame>& KeyFrames = Track.KeyFrames;
+
+		// Sort the key frames: the stable sort keeps the submitted order of the
+		// key frames with the same time, so the first one is kept below.
+		KeyFrames.StableSort();
+
+		// Delete the duplicate KeyFrames, compacting the others in place.
+		int32 KeptNum = 1;
+		for (int32 I = 1; I < KeyFrames.Num(); I += 1)
+		{
+			if (KeyFrames[I].Time != KeyFrames[KeptNum - 1].Time)
+			{
+				if (I != KeptNum)
+				{
+					KeyFrames[KeptNum] = KeyFrames[I];
+				}
+				KeptNum += 1;
+			}
+		}
+		KeyFrames.SetNum(KeptNum, false);
 	}
 
 	// Make sure we have the frame 0.
@@ -92,126 +649,334 @@ void FRuntimeAnimationGenerator::PrepareSkeletonTracks(const USkeleton* Skeleton
 	OutTracks.IsReady = true;
 }
 
-UAnimSequence* FRuntimeAnimationGenerator::GenerateSkeletonAnimSequence(USkeleton* Skeleton, const FTracks& TracksContainer, UObject* Outer)
+namespace
 {
-	if (!ensureAlwaysMsgf(TracksContainer.IsReady, TEXT("Please call `PrepareTracks` before this function.")))
+	/// The raw tracks of a sequence, built without touching any `UObject`.
+	struct FAnimSequenceData
 	{
-		return nullptr;
-	}
+		/// One for each `FTrack`, in the same order.
+		TArray<FRawAnimSequenceTrack> RawTracks;
+		/// The skeleton bone of each `FTrack`.
+		TArray<int32> SkeletonBoneIndices;
+		uint32 NumFrames = 0;
+		double SequenceDuration = 0.0;
+	};
 
-	const TArray<FTrack>& Tracks = TracksContainer.Tracks;
+	/// The buffers `BuildAnimSequenceData` needs only while it runs: each
+	/// worker keeps its own, so the sequences it builds reuse the allocations.
+	struct FAnimSequenceScratch
+	{
+		TArray<FReducedTrack> ReducedTracks;
+	};
 
-	if (Tracks.Num() == 0)
+	/// Reduces and samples the tracks, and resolves their bones. It doesn't
+	/// touch any `UObject`, so it can run on any thread.
+	void BuildAnimSequenceData(
+		const FReferenceSkeleton& RefSkeleton,
+		const TArray<FTrack>& Tracks,
+		const FRuntimeAnimationGenerator::FSampling& Sampling,
+		FAnimSequenceScratch& Scratch,
+		FAnimSequenceData& OutData)
 	{
-		// Nothing to do!
-		return nullptr;
-	}
+		// ~~ Remove the key frames the interpolation rebuilds ~~
+		// Each channel keeps its own key frames, so a noisy channel doesn't keep
+		// the key frames of the others. Only their indices are stored, in the
+		// scratch: the source key frames are never copied.
+		TConstArrayView<FReducedTrack> ReducedTracks;
+		int64 RemovedKeys = 0;
+		if (Sampling.bReduceKeys)
+		{
+			RUNTIME_ANIMATION_PHASE(Reduce);
 
-	TArray<int32> TrackIndices;
-	TrackIndices.Reserve(Tracks.Num());
+			if (Scratch.ReducedTracks.Num() < Tracks.Num())
+			{
+				Scratch.ReducedTracks.SetNum(Tracks.Num());
+			}
+			for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
+			{
+				for (int32 Channel = 0; Channel < ChannelsNum; Channel += 1)
+				{
+					RemovedKeys += ReduceChannel(Tracks[TrackId].KeyFrames, Channel, Sampling, Scratch.ReducedTracks[TrackId].KeyIndices[Channel]);
+				}
+			}
+			ReducedTracks = TConstArrayView<FReducedTrack>(Scratch.ReducedTracks.GetData(), Tracks.Num());
+		}
+		const int32 SampledChannels = ReducedTracks.Num() > 0 ? ChannelsNum : 1;
 
-	UAnimSequence* Anim = NewObject<UAnimSequence>(Outer);
+		// The bones are resolved by `PrepareSkeletonTracks`: they are looked up
+		// again only when the tracks were prepared for another skeleton.
+		OutData.SkeletonBoneIndices.SetNumUninitialized(Tracks.Num());
+		for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
+		{
+			const FTrack& Track = Tracks[TrackId];
+			OutData.SkeletonBoneIndices[TrackId] =
+				RefSkeleton.IsValidIndex(Track.BoneIndex) && RefSkeleton.GetBoneName(Track.BoneIndex) == Track.BoneName
+					? Track.BoneIndex
+					: RefSkeleton.FindBoneIndex(Track.BoneName);
+		}
 
-	// ~~ Initialize the Animation ~~
-	Anim->BoneCompressionSettings = FAnimationUtils::GetDefaultAnimationRecorderBoneCompressionSettings();
-	Anim->SetSkeleton(Skeleton);
-	Anim->SetSequenceLength(0.f);
-	Anim->SetRawNumberOfFrame(0);
+		// ~~ First find the sequence duration and frame interval. ~~
+		double MinKeyInterval = FLT_MAX;
+		double FrameInterval = FLT_MAX;
+		double SequenceDuration = 0.0;
+		int64 SourceKeys = 0;
+		{
+			RUNTIME_ANIMATION_PHASE(Timing);
 
-	// ~~ Initialize the Animation tracks ~~
-	TArray<FName> RuntimeAnimationTrackNames;
-	for (const FTrack& Track : Tracks)
-	{
-		// Pass `nullptr` so we can initialize it later.
-		// It's safe to cast to `AnimSequenceRuntime` since it doesn't add any member.
-		TrackIndices.Push(static_cast<UAnimSequenceRuntime*>(Anim)->AddNewRawTrackRuntime(Track.BoneName, nullptr, RuntimeAnimationTrackNames));
-	}
-#if WITH_EDITOR
-	// ~~ Init notifies ~~
-	Anim->InitializeNotifyTrack();
-#endif
-	// ~~ First find the sequence duration and frame interval. ~~
-	double FrameInterval = FLT_MAX;
-	double SequenceDuration = 0.0;
-	for (const FTrack& Track : Tracks)
-	{
-		double PreviousFrameTime = Track.KeyFrames[0].Time;
-		for (int32 i = 1; i < Track.KeyFrames.Num(); i += 1)
+			for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
+			{
+				const FTrack& Track = Tracks[TrackId];
+				SourceKeys += Track.KeyFrames.Num();
+				SequenceDuration = FMath::Max(Track.KeyFrames.Last().Time, SequenceDuration);
+
+				// Without the reduction, the channels share the key frames.
+				for (int32 Channel = 0; Channel < SampledChannels; Channel += 1)
+				{
+					const FChannelKeys Keys(Track, ReducedTracks.Num() > 0 ? &ReducedTracks[TrackId] : nullptr, Channel);
+					for (int32 i = 1; i < Keys.Num(); i += 1)
+					{
+						const double Delta = Keys[i].Time - Keys[i - 1].Time;
+						checkf(Delta > 0.0, TEXT("At this point this can't go backward."));
+						MinKeyInterval = FMath::Min(MinKeyInterval, Delta);
+					}
+				}
+			}
+
+			// The sequence lasts until the last key, also when all the channels
+			// are constant.
+			if (SequenceDuration > 0.0)
+			{
+				MinKeyInterval = FMath::Min(MinKeyInterval, SequenceDuration);
+			}
+
+			FrameInterval = ComputeFrameInterval(Tracks, ReducedTracks, Sampling, MinKeyInterval, SequenceDuration);
+		}
+
+		// `+ 1` to add the frame 0.
+		const uint32 NumFrames = (FrameInterval == 0.0 ? 0 : FMath::CeilToInt(SequenceDuration / FrameInterval)) + 1;
+		// This is needed to avoid skip the last frame in case of precision loss.
+		OutData.SequenceDuration = (NumFrames - 1) * FrameInterval;
+		OutData.NumFrames = NumFrames;
+
+		// ~~ Fill the animation tracks ~~
+		// Accumulated by the parallel tasks.
+		std::atomic<int64> VectorKeys{0};
+		std::atomic<int64> RotationKeys{0};
+		std::atomic<int64> ConstantChannels{0};
 		{
-			const FKeyFrame& Frame = Track.KeyFrames[i];
+			RUNTIME_ANIMATION_PHASE(FillTracks);
+
+			OutData.RawTracks.SetNum(Tracks.Num());
+
+			// The tracks are independent: sample them in parallel.
+			ParallelFor(Tracks.Num(), [&](const int32 TrackId)
+			{
+				const FTrack& Track = Tracks[TrackId];
+				const FReducedTrack* ReducedTrack = ReducedTracks.Num() > 0 ? &ReducedTracks[TrackId] : nullptr;
+				FRawAnimSequenceTrack& AnimTrack = OutData.RawTracks[TrackId];
 
-			checkf(PreviousFrameTime < Frame.Time, TEXT("At this point this can't go backward."));
-			const double Delta = Frame.Time - PreviousFrameTime;
-			checkf(Delta != 0.0, TEXT("This can't never happen at this point."));
-			FrameInterval = FMath::Min(FrameInterval, Delta);
-			SequenceDuration = FMath::Max(Frame.Time, SequenceDuration);
-			PreviousFrameTime = Frame.Time;
+				// A channel with a single key is constant for the whole sequence.
+				const FChannelKeys PosKeyFrames(Track, ReducedTrack, PositionChannel);
+				const FChannelKeys RotKeyFrames(Track, ReducedTrack, RotationChannel);
+				const FChannelKeys ScaleKeyFrames(Track, ReducedTrack, ScaleChannel);
+				AnimTrack.PosKeys.SetNumUninitialized(PosKeyFrames.Num() == 1 ? 1 : NumFrames);
+				AnimTrack.RotKeys.SetNumUninitialized(RotKeyFrames.Num() == 1 ? 1 : NumFrames);
+				AnimTrack.ScaleKeys.SetNumUninitialized(ScaleKeyFrames.Num() == 1 ? 1 : NumFrames);
+
+				if (ReducedTrack == nullptr)
+				{
+					// The channels share the key frames, so they share the
+					// segments too.
+					SampleKeys(
+						PosKeyFrames,
+						FrameInterval,
+						AnimTrack.PosKeys.Num(),
+						AnimTrack.PosKeys.GetData(),
+						AnimTrack.RotKeys.GetData(),
+						AnimTrack.ScaleKeys.GetData());
+				}
+				else
+				{
+					SampleKeys(PosKeyFrames, FrameInterval, AnimTrack.PosKeys.Num(), AnimTrack.PosKeys.GetData(), nullptr, nullptr);
+					SampleKeys(RotKeyFrames, FrameInterval, AnimTrack.RotKeys.Num(), nullptr, AnimTrack.RotKeys.GetData(), nullptr);
+					SampleKeys(ScaleKeyFrames, FrameInterval, AnimTrack.ScaleKeys.Num(), nullptr, nullptr, AnimTrack.ScaleKeys.GetData());
+				}
+
+				VectorKeys += AnimTrack.PosKeys.Num() + AnimTrack.ScaleKeys.Num();
+				RotationKeys += AnimTrack.RotKeys.Num();
+				ConstantChannels += int32(AnimTrack.PosKeys.Num() == 1) + int32(AnimTrack.RotKeys.Num() == 1) + int32(AnimTrack.ScaleKeys.Num() == 1);
+			});
 		}
-	}
 
-	// `+ 1` to add the frame 0.
-	const uint32 NumFrames = (FrameInterval == 0.0 ? 0 : FMath::CeilToInt(SequenceDuration / FrameInterval)) + 1;
-	// This is needed to avoid skip the last frame in case of precision loss.
-	SequenceDuration = (NumFrames - 1) * FrameInterval;
+		const int64 Frames = int64(NumFrames) * Tracks.Num();
+		const int64 AllocatedBytes = VectorKeys * sizeof(FVector3f) + RotationKeys * sizeof(FQuat4f);
 
-	// ~~ Fill the animation tracks ~~
+		INC_DWORD_STAT_BY(STAT_RuntimeAnimation_Tracks, Tracks.Num());
+		INC_DWORD_STAT_BY(STAT_RuntimeAnimation_SourceKeys, SourceKeys);
+		INC_DWORD_STAT_BY(STAT_RuntimeAnimation_RemovedKeys, RemovedKeys);
+		INC_DWORD_STAT_BY(STAT_RuntimeAnimation_Frames, Frames);
+		INC_DWORD_STAT_BY(STAT_RuntimeAnimation_ConstantChannels, ConstantChannels);
+		INC_DWORD_STAT_BY(STAT_RuntimeAnimation_AllocatedBytes, AllocatedBytes);
+
+		GeneratorStats.Tracks += Tracks.Num();
+		GeneratorStats.SourceKeys += SourceKeys;
+		GeneratorStats.RemovedKeys += RemovedKeys;
+		GeneratorStats.Frames += Frames;
+		GeneratorStats.ConstantChannels += ConstantChannels;
+		GeneratorStats.AllocatedBytes += AllocatedBytes;
+	}
 
-	for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
+	/// Creates the `UAnimSequence` and moves the built raw tracks in it.
+	/// Note: This must run on the game thread.
+	UAnimSequence* CommitAnimSequence(
+		USkeleton* Skeleton,
+		const TArray<FTrack>& Tracks,
+		FAnimSequenceData&& Data,
+		UObject* Outer)
 	{
-		const int32 TrackIndex = TrackIndices[TrackId];
-		const FTrack& Track = Tracks[TrackId];
+		UAnimSequence* Anim = NewObject<UAnimSequence>(Outer);
 
-		FRawAnimSequenceTrack& AnimTrack = Anim->GetRawAnimationTrack(TrackIndex);
-		AnimTrack.PosKeys.SetNum(NumFrames);
-		AnimTrack.RotKeys.SetNum(NumFrames);
-		AnimTrack.ScaleKeys.SetNum(NumFrames);
+		// ~~ Initialize the Animation ~~
+		Anim->BoneCompressionSettings = FAnimationUtils::GetDefaultAnimationRecorderBoneCompressionSettings();
+		Anim->SetSkeleton(Skeleton);
+		Anim->SetSequenceLength(0.f);
+		Anim->SetRawNumberOfFrame(0);
 
-		uint32 FrameId = 0;
-		uint32 NextFrameId = FrameId + 1 >= static_cast<uint32>(Track.KeyFrames.Num()) ? FrameId : (FrameId + 1);
-		for (uint32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex += 1)
+		// ~~ Initialize the Animation tracks ~~
+		TArray<FName> TrackNames;
+		TrackNames.SetNumUninitialized(Tracks.Num());
+		for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
 		{
-			const double Time = FrameInterval * static_cast<double>(FrameIndex);
+			TrackNames[TrackId] = Tracks[TrackId].BoneName;
+		}
+		TArray<int32> TrackIndices;
+		// It's safe to cast to `AnimSequenceRuntime` since it doesn't add any member.
+		static_cast<UAnimSequenceRuntime*>(Anim)->AddNewRawTracksRuntime(TrackNames, Data.SkeletonBoneIndices, TrackIndices);
+#if WITH_EDITOR
+		// ~~ Init notifies ~~
+		Anim->InitializeNotifyTrack();
+#endif
 
-			if (NextFrameId < static_cast<uint32>(Track.KeyFrames.Num()))
+		// ~~ Finalize the animation ~~
+		{
+			RUNTIME_ANIMATION_PHASE(Finalize);
+
+			for (int32 TrackId = 0; TrackId < Tracks.Num(); TrackId += 1)
 			{
-				if (Time >= Track.KeyFrames[NextFrameId].Time)
+				if (TrackIndices[TrackId] != INDEX_NONE)
 				{
-					// Time to advance to the next frame.
-					FrameId = NextFrameId;
-					NextFrameId = FrameId + 1 >= static_cast<uint32>(Track.KeyFrames.Num()) ? FrameId : (FrameId + 1);
+					Anim->GetRawAnimationTrack(TrackIndices[TrackId]) = MoveTemp(Data.RawTracks[TrackId]);
 				}
 			}
 
-			if (FrameId == NextFrameId)
-			{
-				// This is the last frame, nothing to interpolate.
-				const FKeyFrame& Frame = Track.KeyFrames[FrameId];
-				AnimTrack.PosKeys[FrameIndex] = FVector3f(Frame.Position);
-				AnimTrack.RotKeys[FrameIndex] = FQuat4f(Frame.Rotation);
-				AnimTrack.ScaleKeys[FrameIndex] = FVector3f(Frame.Scale);
-			}
-			else
-			{
-				const FKeyFrame& Frame1 = Track.KeyFrames[FrameId];
-				const FKeyFrame& Frame2 = Track.KeyFrames[NextFrameId];
+			Anim->SetRawNumberOfFrame(Data.NumFrames);
+			Anim->SetSequenceLength(Data.SequenceDuration);
+#if WITH_EDITOR
+			Anim->PostProcessSequence();
+#endif
+			Anim->MarkPackageDirty();
+		}
 
-				checkf(Frame1.Time < Frame2.Time, TEXT("This is is impossible because the `Prepare` clears all the duplicate key frames."));
-				const auto Alpha = FMath::Clamp((Time - Frame1.Time) / (Frame2.Time - Frame1.Time), 0.0, 1.0);
+		GeneratorStats.GeneratedSequences += 1;
+		return Anim;
+	}
+}
 
-				AnimTrack.PosKeys[FrameIndex] = FVector3f(FMath::Lerp(Frame1.Position, Frame2.Position, Alpha));
-				AnimTrack.RotKeys[FrameIndex] = FQuat4f(FQuat::Slerp(Frame1.Rotation, Frame2.Rotation, Alpha));
-				AnimTrack.ScaleKeys[FrameIndex] = FVector3f(FMath::Lerp(Frame1.Scale, Frame2.Scale, Alpha));
-			}
+UAnimSequence* FRuntimeAnimationGenerator::GenerateSkeletonAnimSequence(USkeleton* Skeleton, const FTracks& TracksContainer, UObject* Outer)
+{
+	return GenerateSkeletonAnimSequence(Skeleton, TracksContainer, FSampling(), Outer);
+}
+
+UAnimSequence* FRuntimeAnimationGenerator::GenerateSkeletonAnimSequence(USkeleton* Skeleton, const FTracks& TracksContainer, const FSampling& Sampling, UObject* Outer)
+{
+	if (!ensureAlwaysMsgf(TracksContainer.IsReady, TEXT("Please call `PrepareTracks` before this function.")))
+	{
+		return nullptr;
+	}
+
+	if (TracksContainer.Tracks.Num() == 0)
+	{
+		// Nothing to do!
+		return nullptr;
+	}
+
+	FAnimSequenceScratch Scratch;
+	FAnimSequenceData Data;
+	BuildAnimSequenceData(Skeleton->GetReferenceSkeleton(), TracksContainer.Tracks, Sampling, Scratch, Data);
+	return CommitAnimSequence(Skeleton, TracksContainer.Tracks, MoveTemp(Data), Outer);
+}
+
+TArray<UAnimSequence*> FRuntimeAnimationGenerator::GenerateSkeletonAnimSequences(USkeleton* Skeleton, TArrayView<FTracks> TracksList, const FSampling& Sampling, UObject* Outer)
+{
+	check(IsInGameThread());
+
+	// Everything but the `UAnimSequence` creation is done in parallel, one
+	// sequence for each task; the tasks of a worker share its scratch.
+	TArray<FAnimSequenceData> SequencesData;
+	SequencesData.SetNum(TracksList.Num());
+	TArray<FAnimSequenceScratch> WorkersScratch;
+	ParallelForWithTaskContext(WorkersScratch, TracksList.Num(), [&](FAnimSequenceScratch& Scratch, const int32 SequenceIndex)
+	{
+		FTracks& Tracks = TracksList[SequenceIndex];
+		if (!Tracks.IsReady)
+		{
+			PrepareSkeletonTracks(Skeleton, Tracks);
+		}
+		if (Tracks.Tracks.Num() > 0)
+		{
+			BuildAnimSequenceData(Skeleton->GetReferenceSkeleton(), Tracks.Tracks, Sampling, Scratch, SequencesData[SequenceIndex]);
 		}
+	});
+
+	TArray<UAnimSequence*> Sequences;
+	Sequences.Reserve(TracksList.Num());
+	for (int32 SequenceIndex = 0; SequenceIndex < TracksList.Num(); SequenceIndex += 1)
+	{
+		const FTracks& Tracks = TracksList[SequenceIndex];
+		Sequences.Add(
+			Tracks.Tracks.Num() > 0
+				? CommitAnimSequence(Skeleton, Tracks.Tracks, MoveTemp(SequencesData[SequenceIndex]), Outer)
+				: nullptr);
 	}
+	return Sequences;
+}
 
-	// ~~ Finalize the animation ~~
-	Anim->SetRawNumberOfFrame(NumFrames);
-	Anim->SetSequenceLength(SequenceDuration);
-#if WITH_EDITOR
-	Anim->PostProcessSequence();
-#endif
-	Anim->MarkPackageDirty();
+FRuntimeAnimationGenerator::FStats FRuntimeAnimationGenerator::GetStats()
+{
+	FStats Stats;
+	Stats.PreparedTracks = GeneratorStats.PreparedTracks;
+	Stats.GeneratedSequences = GeneratorStats.GeneratedSequences;
+
+	Stats.PrepareSeconds = FPlatformTime::ToSeconds64(GeneratorStats.PrepareCycles);
+	Stats.ReduceSeconds = FPlatformTime::ToSeconds64(GeneratorStats.ReduceCycles);
+	Stats.TimingSeconds = FPlatformTime::ToSeconds64(GeneratorStats.TimingCycles);
+	Stats.FillTracksSeconds = FPlatformTime::ToSeconds64(GeneratorStats.FillTracksCycles);
+	Stats.FinalizeSeconds = FPlatformTime::ToSeconds64(GeneratorStats.FinalizeCycles);
+
+	Stats.Tracks = GeneratorStats.Tracks;
+	Stats.SourceKeys = GeneratorStats.SourceKeys;
+	Stats.RemovedKeys = GeneratorStats.RemovedKeys;
+	Stats.Frames = GeneratorStats.Frames;
+	Stats.ConstantChannels = GeneratorStats.ConstantChannels;
+	Stats.AllocatedBytes = GeneratorStats.AllocatedBytes;
+	return Stats;
+}
+
+void FRuntimeAnimationGenerator::ResetStats()
+{
+	GeneratorStats.PreparedTracks = 0;
+	GeneratorStats.GeneratedSequences = 0;
+
+	GeneratorStats.PrepareCycles = 0;
+	GeneratorStats.ReduceCycles = 0;
+	GeneratorStats.TimingCycles = 0;
+	GeneratorStats.FillTracksCycles = 0;
+	GeneratorStats.FinalizeCycles = 0;
 
-	return Anim;
+	GeneratorStats.Tracks = 0;
+	GeneratorStats.SourceKeys = 0;
+	GeneratorStats.RemovedKeys = 0;
+	GeneratorStats.Frames = 0;
+	GeneratorStats.ConstantChannels = 0;
+	GeneratorStats.AllocatedBytes = 0;
 }
@@ -51,6 +51,10 @@ public:
 	{
 		FName BoneName;
 		TArray<FKeyFrame> KeyFrames;
+		/// The index of `BoneName` in the skeleton. Set it when it's already
+		/// known (e.g. resolved once for a stream of clips) to skip the lookup,
+		/// otherwise `PrepareSkeletonTracks` resolves it.
+		int32 BoneIndex = INDEX_NONE;
 
 		bool operator==(const FName& Name) const
 		{
@@ -83,10 +87,100 @@ public:
 		}
 	};
 
+	/// How the key frames are resampled to the uniform frames of the
+	/// `UAnimSequence`.
+	enum class ESamplingMode : uint8
+	{
+		/// The frame interval is the smallest delta between two key frames of
+		/// any track. The source keys are kept exactly, but two close keys
+		/// increase the frames of the whole sequence.
+		MinKeyInterval,
+		/// The frames are sampled at `SampleRate`.
+		FixedRate,
+		/// The lowest rate, up to `SampleRate`, that reproduces every source key
+		/// within the error bounds: the frames scale with the keys density.
+		Adaptive,
+	};
+
+	struct RUNTIMEANIMATIONGENERATOR_API FSampling
+	{
+		ESamplingMode Mode = ESamplingMode::MinKeyInterval;
+		/// The frames per second of `FixedRate`, and the max of `Adaptive`.
+		double SampleRate = 30.0;
+		/// The max distance of the resampled positions from the source keys.
+		float MaxPositionError = 0.01f;
+		/// The max angle, in radians, of the resampled rotations from the
+		/// source keys.
+		float MaxRotationError = 0.001f;
+		/// The max difference of each resampled scale component from the source
+		/// keys.
+		float MaxScaleError = 0.001f;
+
+		/// Remove the source keys that the interpolation of the keys around
+		/// them rebuilds within the above error bounds, and store a single key
+		/// for the channels that stay constant within them. The position,
+		/// rotation and scale of each track are reduced on their own, and at
+		/// most 32 consecutive keys are removed, so it takes linear time.
+		/// With `Adaptive`, the rate is still checked against all the source
+		/// keys, so the reduced keys never double the error bounds.
+		bool bReduceKeys = false;
+	};
+
+	/// Where the generator spent time and memory, accumulated since the last
+	/// `ResetStats`. The same data is shown by `stat RuntimeAnimationGenerator`.
+	struct RUNTIMEANIMATIONGENERATOR_API FStats
+	{
+		int64 PreparedTracks = 0;
+		int64 GeneratedSequences = 0;
+
+		double PrepareSeconds = 0.0;
+		/// Time spent to remove the redundant key frames.
+		double ReduceSeconds = 0.0;
+		/// Time spent to find the sequence duration and frame interval, which
+		/// includes the error checks of `ESamplingMode::Adaptive`.
+		double TimingSeconds = 0.0;
+		double FillTracksSeconds = 0.0;
+		double FinalizeSeconds = 0.0;
+
+		int64 Tracks = 0;
+		/// The key frames submitted.
+		int64 SourceKeys = 0;
+		/// The keys removed by `FSampling::bReduceKeys`: each key frame has a
+		/// position, a rotation and a scale key.
+		int64 RemovedKeys = 0;
+		/// The key frames generated, for each track.
+		int64 Frames = 0;
+		/// The position, rotation and scale channels stored with a single key.
+		int64 ConstantChannels = 0;
+		/// The bytes allocated by the raw animation tracks.
+		int64 AllocatedBytes = 0;
+	};
+
 public:
+	/// Resolves the bone of each track and removes the tracks without keys or
+	/// bone, then sorts the key frames of each track, drops the ones with the
+	/// same time and adds the frame 0. It takes linear time, after the sort.
 	static void PrepareSkeletonTracks(const USkeleton* Skeleton, FTracks& OutTracks);
 
 	/// Generates a new `AnimSequence` using the passed Tracks.
 	/// Note, it's important to use `PrepareTracks` just before using this function.
 	static UAnimSequence* GenerateSkeletonAnimSequence(USkeleton* Skeleton, const FTracks& Tracks, UObject* Outer = GetTransientPackage());
+
+	/// Generates a new `AnimSequence` using the passed Tracks, resampled as
+	/// specified by `Sampling`.
+	static UAnimSequence* GenerateSkeletonAnimSequence(USkeleton* Skeleton, const FTracks& Tracks, const FSampling& Sampling, UObject* Outer = GetTransientPackage());
+
+	/// Generates an `AnimSequence` for each of `TracksList`, all for the same
+	/// `Skeleton`. The tracks not ready yet are prepared. The tracks are
+	/// prepared, sampled and their bones resolved in parallel: only the
+	/// `UAnimSequence` creation runs on the calling thread, the game thread.
+	/// The sequences are in the `TracksList` order, `nullptr` when the tracks
+	/// are empty.
+	static TArray<UAnimSequence*> GenerateSkeletonAnimSequences(USkeleton* Skeleton, TArrayView<FTracks> TracksList, const FSampling& Sampling, UObject* Outer = GetTransientPackage());
+
+	/// Returns the time and memory spent by the generator since the last
+	/// `ResetStats`.
+	static FStats GetStats();
+
+	static void ResetStats();
 };
@@ -0,0 +1,55 @@
+#include "RuntimeAnimationGenerator.h"
+#include "RuntimeGeneratorBenchmark.h"
+
+#include "Animation/AnimSequence.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 Iterations = 3;
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+	FRuntimeAnimationGenerateBenchmark,
+	"RuntimeAnimationGenerator.Benchmark.GenerateSkeletonAnimSequence",
+	RUNTIME_GENERATOR_BENCHMARK_FLAGS)
+
+void FRuntimeAnimationGenerateBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	// The bones and the keys of each track, from a short clip of a prop to a
+	// long motion capture of a character.
+	const FIntPoint Cases[] = {{64, 100}, {256, 1000}, {256, 10 * 1000}, {1024, 10 * 1000}};
+	for (const FIntPoint& Case : Cases)
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%i bones, %i keys"), Case.X, Case.Y));
+		OutTestCommands.Add(FString::Printf(TEXT("%i %i"), Case.X, Case.Y));
+	}
+}
+
+bool FRuntimeAnimationGenerateBenchmark::RunTest(const FString& Parameters)
+{
+	FString Bones;
+	FString Keys;
+	Parameters.Split(TEXT(" "), &Bones, &Keys);
+	const int32 BonesNum = FCString::Atoi(*Bones);
+	const int32 KeysNum = FCString::Atoi(*Keys);
+
+	USkeleton* Skeleton = FRuntimeGeneratorBenchmark::MakeSkeleton(BonesNum);
+	FRuntimeAnimationGenerator::FTracks Tracks;
+	FRuntimeGeneratorBenchmark::MakeTracks(Skeleton, KeysNum, Tracks);
+	FRuntimeAnimationGenerator::PrepareSkeletonTracks(Skeleton, Tracks);
+
+	bool bGenerated = true;
+	const FRuntimeGeneratorBenchmarkResult Result = FRuntimeGeneratorBenchmark::Measure(Iterations, [&]()
+	{
+		bGenerated &= FRuntimeAnimationGenerator::GenerateSkeletonAnimSequence(Skeleton, Tracks) != nullptr;
+	});
+
+	TestTrue(TEXT("The sequence is generated"), bGenerated);
+	FRuntimeGeneratorBenchmark::Report(*this, Parameters, Result, int64(BonesNum) * KeysNum, TEXT("keys"));
+	return true;
+}
+
+#endif
@@ -0,0 +1,293 @@
+#include "RuntimeGeneratorBenchmark.h"
+
+#include "Animation/Skeleton.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+#include "Modules/ModuleManager.h"
+#include "ReferenceSkeleton.h"
+
+#include <atomic>
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, RuntimeGeneratorBenchmarks)
+
+namespace
+{
+	/// Forwards everything to the engine allocator, and counts the allocations
+	/// and the bytes alive. It's installed only while measuring.
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner = nullptr;
+		std::atomic<int64> Allocations{0};
+		std::atomic<int64> AllocatedBytes{0};
+		std::atomic<int64> LiveBytes{0};
+		std::atomic<int64> PeakBytes{0};
+
+		void Reset()
+		{
+			Allocations = 0;
+			AllocatedBytes = 0;
+			LiveBytes = 0;
+			PeakBytes = 0;
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Ptr = Inner->Malloc(Count, Alignment);
+			Allocations += 1;
+			AllocatedBytes += Count;
+			AddLiveBytes(GetSize(Ptr));
+			return Ptr;
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			const int64 OriginalSize = GetSize(Original);
+			void* Ptr = Inner->Realloc(Original, Count, Alignment);
+			if (Count > 0)
+			{
+				Allocations += 1;
+				AllocatedBytes += Count;
+			}
+			AddLiveBytes(GetSize(Ptr) - OriginalSize);
+			return Ptr;
+		}
+
+		virtual void Free(void* Original) override
+		{
+			AddLiveBytes(-GetSize(Original));
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			Inner->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			Inner->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return Inner->ValidateHeap();
+		}
+
+		virtual void UpdateStats() override
+		{
+			Inner->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			Inner->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			Inner->DumpAllocatorStats(Ar);
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return Inner->GetDescriptiveName();
+		}
+
+	private:
+		/// The allocators that don't track the sizes return 0: only the peak
+		/// bytes are affected.
+		int64 GetSize(void* Ptr) const
+		{
+			SIZE_T Size = 0;
+			return Ptr != nullptr && Inner->GetAllocationSize(Ptr, Size) ? int64(Size) : 0;
+		}
+
+		void AddLiveBytes(const int64 Bytes)
+		{
+			const int64 Live = LiveBytes.fetch_add(Bytes) + Bytes;
+			int64 Peak = PeakBytes.load();
+			while (Live > Peak && !PeakBytes.compare_exchange_weak(Peak, Live))
+			{
+			}
+		}
+	};
+
+	/// Never destroyed: the threads that read `GMalloc` while it's installed can
+	/// still call it once it's removed.
+	FCountingMalloc CountingMalloc;
+}
+
+FRuntimeGeneratorBenchmarkResult FRuntimeGeneratorBenchmark::Measure(const int32 Iterations, TFunctionRef<void()> Body)
+{
+	check(IsInGameThread());
+	check(Iterations > 0);
+
+	Body();
+
+	FRuntimeGeneratorBenchmarkResult Result;
+	for (int32 I = 0; I < Iterations; I += 1)
+	{
+		CountingMalloc.Inner = GMalloc;
+		CountingMalloc.Reset();
+		GMalloc = &CountingMalloc;
+
+		const double StartTime = FPlatformTime::Seconds();
+		Body();
+		Result.Seconds += FPlatformTime::Seconds() - StartTime;
+
+		GMalloc = CountingMalloc.Inner;
+
+		Result.Allocations += CountingMalloc.Allocations;
+		Result.AllocatedBytes += CountingMalloc.AllocatedBytes;
+		Result.PeakBytes = FMath::Max(Result.PeakBytes, CountingMalloc.PeakBytes.load());
+	}
+
+	Result.Seconds /= Iterations;
+	Result.Allocations /= Iterations;
+	Result.AllocatedBytes /= Iterations;
+	return Result;
+}
+
+void FRuntimeGeneratorBenchmark::Report(
+	FAutomationTestBase& Test,
+	const FString& Case,
+	const FRuntimeGeneratorBenchmarkResult& Result,
+	const int64 Elements,
+	const TCHAR* ElementsName)
+{
+	const double Throughput = Result.Seconds > 0.0 ? Elements / Result.Seconds : 0.0;
+	Test.AddInfo(FString::Printf(
+		TEXT("%s: %.3f ms, %.0f %s/s, %lld allocations (%lld bytes), peak %lld bytes, process peak %llu bytes."),
+		*Case,
+		Result.Seconds * 1000.0,
+		Throughput,
+		ElementsName,
+		Result.Allocations,
+		Result.AllocatedBytes,
+		Result.PeakBytes,
+		uint64(FPlatformMemory::GetStats().PeakUsedPhysical)));
+}
+
+USkeleton* FRuntimeGeneratorBenchmark::MakeSkeleton(const int32 BonesNum)
+{
+	USkeleton* Skeleton = NewObject<USkeleton>();
+	{
+		FReferenceSkeletonModifier Modifier(Skeleton);
+		for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex += 1)
+		{
+			const FName BoneName(*FString::Printf(TEXT("Bone_%i"), BoneIndex));
+			const int32 ParentIndex = BoneIndex == 0 ? INDEX_NONE : (BoneIndex - 1) / 2;
+			Modifier.Add(
+				FMeshBoneInfo(BoneName, BoneName.ToString(), ParentIndex),
+				FTransform(FVector(0.0, 0.0, 10.0)));
+		}
+	}
+	return Skeleton;
+}
+
+void FRuntimeGeneratorBenchmark::MakeSurfaces(
+	const int32 VerticesNum,
+	const int32 SurfacesNum,
+	const int32 BonesNum,
+	TArray<FPackedMeshSurface>& OutSurfaces)
+{
+	constexpr int32 Columns = 256;
+	constexpr int32 Influences = 4;
+	constexpr float InfluenceWeights[Influences] = {0.4f, 0.3f, 0.2f, 0.1f};
+
+	OutSurfaces.SetNum(SurfacesNum);
+	for (int32 SurfaceIndex = 0; SurfaceIndex < SurfacesNum; SurfaceIndex += 1)
+	{
+		// Whole rows, so the grid has no holes.
+		const int32 Rows = FMath::Max(2, VerticesNum / SurfacesNum / Columns);
+		const int32 SurfaceVerticesNum = Rows * Columns;
+
+		FPackedMeshSurface& Surface = OutSurfaces[SurfaceIndex];
+		Surface.MaterialIndex = SurfaceIndex;
+		Surface.UVChannels = 1;
+		Surface.InfluenceSlots = Influences;
+		Surface.Vertices.SetNumUninitialized(SurfaceVerticesNum);
+		Surface.Tangents.Init(FVector3f(1.0f, 0.0f, 0.0f), SurfaceVerticesNum);
+		Surface.Normals.Init(FVector3f(0.0f, 0.0f, 1.0f), SurfaceVerticesNum);
+		Surface.Uvs.SetNumUninitialized(SurfaceVerticesNum);
+		Surface.Colors.Init(FColor::White, SurfaceVerticesNum);
+		Surface.FlipBinormalSigns.Init(false, SurfaceVerticesNum);
+		Surface.InfluenceBones.SetNumUninitialized(SurfaceVerticesNum * Influences);
+		Surface.InfluenceWeights.SetNumUninitialized(SurfaceVerticesNum * Influences);
+
+		for (int32 VertexIndex = 0; VertexIndex < SurfaceVerticesNum; VertexIndex += 1)
+		{
+			const int32 Row = VertexIndex / Columns;
+			const int32 Column = VertexIndex % Columns;
+			Surface.Vertices[VertexIndex] = FVector3f(Column, Row, SurfaceIndex);
+			Surface.Uvs[VertexIndex] = FVector2f(float(Column) / (Columns - 1), float(Row) / (Rows - 1));
+			for (int32 InfluenceIndex = 0; InfluenceIndex < Influences; InfluenceIndex += 1)
+			{
+				const int32 Slot = VertexIndex * Influences + InfluenceIndex;
+				Surface.InfluenceBones[Slot] = FBoneIndexType((Row + SurfaceIndex * 7 + InfluenceIndex * 13) % BonesNum);
+				Surface.InfluenceWeights[Slot] = InfluenceWeights[InfluenceIndex];
+			}
+		}
+
+		Surface.Indices.Reserve((Rows - 1) * (Columns - 1) * 6);
+		for (int32 Row = 0; Row < Rows - 1; Row += 1)
+		{
+			for (int32 Column = 0; Column < Columns - 1; Column += 1)
+			{
+				const uint32 Corner = Row * Columns + Column;
+				Surface.Indices.Append({Corner, Corner + Columns, Corner + 1});
+				Surface.Indices.Append({Corner + 1, Corner + Columns, Corner + Columns + 1});
+			}
+		}
+	}
+}
+
+void FRuntimeGeneratorBenchmark::MakeTracks(
+	const USkeleton* Skeleton,
+	const int32 KeysNum,
+	FRuntimeAnimationGenerator::FTracks& OutTracks)
+{
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	TArray<FRuntimeAnimationGenerator::FTrack>& Tracks = OutTracks.GetTracks_mutable();
+	Tracks.SetNum(RefSkeleton.GetRawBoneNum());
+	for (int32 BoneIndex = 0; BoneIndex < Tracks.Num(); BoneIndex += 1)
+	{
+		FRuntimeAnimationGenerator::FTrack& Track = Tracks[BoneIndex];
+		Track.BoneName = RefSkeleton.GetBoneName(BoneIndex);
+		Track.KeyFrames.SetNum(KeysNum);
+
+		const bool bConstant = BoneIndex % 4 == 3;
+		for (int32 KeyIndex = 0; KeyIndex < KeysNum; KeyIndex += 1)
+		{
+			const double Time = KeyIndex / 30.0;
+			const double Phase = bConstant ? 0.0 : Time + BoneIndex;
+			Track.KeyFrames[KeyIndex] = FRuntimeAnimationGenerator::FKeyFrame(
+				Time,
+				FVector(FMath::Sin(Phase), FMath::Cos(Phase), 10.0),
+				FQuat(FVector::UpVector, FMath::Sin(Phase * 2.0)),
+				FVector::OneVector);
+		}
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAnimationGenerator.h"
+#include "RuntimeSkeletalMeshGenerator.h"
+
+class FAutomationTestBase;
+class USkeleton;
+
+/// The flags of the benchmarks: they run in any application, also headless
+/// (`-nullrhi`), and are listed with the performance tests.
+#define RUNTIME_GENERATOR_BENCHMARK_FLAGS (EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/// The cost of a single run of a benchmark case.
+struct FRuntimeGeneratorBenchmarkResult
+{
+	double Seconds = 0.0;
+	/// The allocations, and reallocations, done by each run.
+	int64 Allocations = 0;
+	int64 AllocatedBytes = 0;
+	/// The max bytes alive at the same time, above the ones alive when the run
+	/// started.
+	int64 PeakBytes = 0;
+};
+
+/// Measures the generators and builds their synthetic inputs.
+/// The allocations are counted on every thread, so the workers of the
+/// generators are included: keep the engine idle while measuring, which is
+/// the case of an automation run under `-nullrhi`.
+class FRuntimeGeneratorBenchmark
+{
+public:
+	/// Runs `Body` once to warm up, then `Iterations` times: returns the
+	/// average time and allocations of a run, and the highest peak.
+	static FRuntimeGeneratorBenchmarkResult Measure(const int32 Iterations, TFunctionRef<void()> Body);
+
+	/// Reports the result, with the throughput of `Elements` `ElementsName`
+	/// processed by each run, to the test and to the log.
+	static void Report(
+		FAutomationTestBase& Test,
+		const FString& Case,
+		const FRuntimeGeneratorBenchmarkResult& Result,
+		const int64 Elements,
+		const TCHAR* ElementsName);
+
+	/// A skeleton of `BonesNum` bones, laid out as a balanced binary tree.
+	static USkeleton* MakeSkeleton(const int32 BonesNum);
+
+	/// `SurfacesNum` grids with `VerticesNum` vertices in total, each vertex is
+	/// influenced by 4 of the first `BonesNum` bones.
+	static void MakeSurfaces(
+		const int32 VerticesNum,
+		const int32 SurfacesNum,
+		const int32 BonesNum,
+		TArray<FPackedMeshSurface>& OutSurfaces);
+
+	/// A track of `KeysNum` keys, at 30 frames per second, for each bone of the
+	/// `Skeleton`. One bone out of four doesn't move.
+	static void MakeTracks(
+		const USkeleton* Skeleton,
+		const int32 KeysNum,
+		FRuntimeAnimationGenerator::FTracks& OutTracks);
+};
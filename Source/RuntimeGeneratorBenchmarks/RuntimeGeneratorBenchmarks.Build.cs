@@ -0,0 +1,19 @@
+using UnrealBuildTool;
+
+public class RuntimeGeneratorBenchmarks : ModuleRules
+{
+	public RuntimeGeneratorBenchmarks(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"RuntimeSkeletalMeshGenerator",
+				"RuntimeAnimationGenerator",
+			});
+	}
+}
@@ -0,0 +1,227 @@
+#include "RuntimeGeneratorBenchmark.h"
+#include "RuntimeSkeletalMeshGenerator.h"
+#include "RuntimeSkeletonBoneTransformExtractor.h"
+
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 Iterations = 3;
+	constexpr int32 MeshBonesNum = 256;
+
+	/// The vertices and surfaces of the mesh cases, from a single prop to a
+	/// fully dressed character.
+	void GetMeshCases(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands)
+	{
+		const FIntPoint Cases[] = {{10 * 1000, 1}, {100 * 1000, 10}, {500 * 1000, 40}, {1000 * 1000, 40}};
+		for (const FIntPoint& Case : Cases)
+		{
+			OutBeautifiedNames.Add(FString::Printf(TEXT("%i vertices, %i surfaces"), Case.X, Case.Y));
+			OutTestCommands.Add(FString::Printf(TEXT("%i %i"), Case.X, Case.Y));
+		}
+	}
+
+	void ParseMeshCase(const FString& Parameters, int32& OutVerticesNum, int32& OutSurfacesNum)
+	{
+		FString Vertices;
+		FString Surfaces;
+		Parameters.Split(TEXT(" "), &Vertices, &Surfaces);
+		OutVerticesNum = FCString::Atoi(*Vertices);
+		OutSurfacesNum = FCString::Atoi(*Surfaces);
+	}
+
+	USkeletalMesh* MakeSkeletalMesh(USkeleton* Skeleton)
+	{
+		USkeletalMesh* SkeletalMesh = NewObject<USkeletalMesh>();
+		SkeletalMesh->SetRefSkeleton(Skeleton->GetReferenceSkeleton());
+		SkeletalMesh->SetSkeleton(Skeleton);
+		return SkeletalMesh;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+	FRuntimeSkeletalMeshGenerateBenchmark,
+	"RuntimeSkeletalMeshGenerator.Benchmark.GenerateSkeletalMesh",
+	RUNTIME_GENERATOR_BENCHMARK_FLAGS)
+
+void FRuntimeSkeletalMeshGenerateBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	GetMeshCases(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRuntimeSkeletalMeshGenerateBenchmark::RunTest(const FString& Parameters)
+{
+	int32 VerticesNum = 0;
+	int32 SurfacesNum = 0;
+	ParseMeshCase(Parameters, VerticesNum, SurfacesNum);
+
+	USkeleton* Skeleton = FRuntimeGeneratorBenchmark::MakeSkeleton(MeshBonesNum);
+	TArray<FPackedMeshSurface> Surfaces;
+	FRuntimeGeneratorBenchmark::MakeSurfaces(VerticesNum, SurfacesNum, MeshBonesNum, Surfaces);
+	TArray<UMaterialInterface*> SurfacesMaterial;
+	SurfacesMaterial.Init(nullptr, SurfacesNum);
+
+	bool bGenerated = true;
+	const FRuntimeGeneratorBenchmarkResult Result = FRuntimeGeneratorBenchmark::Measure(Iterations, [&]()
+	{
+		bGenerated &= FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(
+			MakeSkeletalMesh(Skeleton),
+			Surfaces,
+			SurfacesMaterial);
+	});
+
+	TestTrue(TEXT("The mesh is generated"), bGenerated);
+	FRuntimeGeneratorBenchmark::Report(*this, Parameters, Result, VerticesNum, TEXT("vertices"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRuntimeSkeletalMeshParallelPackBenchmark,
+	"RuntimeSkeletalMeshGenerator.Benchmark.ParallelPack",
+	RUNTIME_GENERATOR_BENCHMARK_FLAGS)
+
+bool FRuntimeSkeletalMeshParallelPackBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 VerticesNum = 500 * 1000;
+	constexpr int32 SurfacesNum = 40;
+
+	USkeleton* Skeleton = FRuntimeGeneratorBenchmark::MakeSkeleton(MeshBonesNum);
+	TArray<FPackedMeshSurface> Surfaces;
+	FRuntimeGeneratorBenchmark::MakeSurfaces(VerticesNum, SurfacesNum, MeshBonesNum, Surfaces);
+	TArray<UMaterialInterface*> SurfacesMaterial;
+	SurfacesMaterial.Init(nullptr, SurfacesNum);
+
+	// Only the build is measured: the commit doesn't depend on the packing.
+	double PackSeconds[2] = {0.0, 0.0};
+	FRuntimeSkeletalMeshGenerator::ResetStats();
+	for (const bool bParallelPack : {false, true})
+	{
+		FRuntimeSkeletalMeshBuildOptions BuildOptions;
+		BuildOptions.bParallelPack = bParallelPack;
+
+		bool bBuilt = true;
+		const FRuntimeGeneratorBenchmarkResult Result = FRuntimeGeneratorBenchmark::Measure(Iterations, [&]()
+		{
+			FRuntimeSkeletalMeshLODData LODData;
+			bBuilt &= FRuntimeSkeletalMeshGenerator::BuildSkeletalMeshLODData(
+				Skeleton->GetReferenceSkeleton(),
+				Surfaces,
+				SurfacesMaterial,
+				TMap<FName, FTransform>(),
+				LODData,
+				BuildOptions);
+		});
+
+		// The stats include the warm up run.
+		const FRuntimeSkeletalMeshGeneratorStats Stats = FRuntimeSkeletalMeshGenerator::GetStats();
+		FRuntimeSkeletalMeshGenerator::ResetStats();
+		PackSeconds[bParallelPack] = (Stats.PackSeconds + Stats.IndicesSeconds) / (Iterations + 1);
+
+		TestTrue(TEXT("The LOD is built"), bBuilt);
+		FRuntimeGeneratorBenchmark::Report(*this, bParallelPack ? TEXT("Parallel") : TEXT("Serial"), Result, VerticesNum, TEXT("vertices"));
+	}
+
+	AddInfo(FString::Printf(
+		TEXT("Pack and Indices phases: serial %.3f ms, parallel %.3f ms, speedup %.2fx."),
+		PackSeconds[0] * 1000.0,
+		PackSeconds[1] * 1000.0,
+		PackSeconds[1] > 0.0 ? PackSeconds[0] / PackSeconds[1] : 0.0));
+	return true;
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+	FRuntimeSkeletalMeshDecomposeBenchmark,
+	"RuntimeSkeletalMeshGenerator.Benchmark.DecomposeSkeletalMesh",
+	RUNTIME_GENERATOR_BENCHMARK_FLAGS)
+
+void FRuntimeSkeletalMeshDecomposeBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	GetMeshCases(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRuntimeSkeletalMeshDecomposeBenchmark::RunTest(const FString& Parameters)
+{
+	int32 VerticesNum = 0;
+	int32 SurfacesNum = 0;
+	ParseMeshCase(Parameters, VerticesNum, SurfacesNum);
+
+	USkeleton* Skeleton = FRuntimeGeneratorBenchmark::MakeSkeleton(MeshBonesNum);
+	TArray<FPackedMeshSurface> Surfaces;
+	FRuntimeGeneratorBenchmark::MakeSurfaces(VerticesNum, SurfacesNum, MeshBonesNum, Surfaces);
+	TArray<UMaterialInterface*> SurfacesMaterial;
+	SurfacesMaterial.Init(nullptr, SurfacesNum);
+
+	// The buffers are read back from the CPU copy.
+	USkeletalMesh* SkeletalMesh = MakeSkeletalMesh(Skeleton);
+	if (!TestTrue(TEXT("The mesh is generated"), FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(SkeletalMesh, Surfaces, SurfacesMaterial, true)))
+	{
+		return false;
+	}
+
+	bool bDecomposed = true;
+	const FRuntimeGeneratorBenchmarkResult Result = FRuntimeGeneratorBenchmark::Measure(Iterations, [&]()
+	{
+		TArray<FPackedMeshSurface> OutSurfaces;
+		TArray<int32> OutSurfacesVertexOffsets;
+		TArray<int32> OutSurfacesIndexOffsets;
+		TArray<UMaterialInterface*> OutSurfacesMaterial;
+		bDecomposed &= FRuntimeSkeletalMeshGenerator::DecomposeSkeletalMesh(
+			SkeletalMesh,
+			OutSurfaces,
+			OutSurfacesVertexOffsets,
+			OutSurfacesIndexOffsets,
+			OutSurfacesMaterial);
+	});
+
+	TestTrue(TEXT("The mesh is decomposed"), bDecomposed);
+	FRuntimeGeneratorBenchmark::Report(*this, Parameters, Result, VerticesNum, TEXT("vertices"));
+	return true;
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+	FRuntimeSkeletonBoneTransformExtractorBenchmark,
+	"RuntimeSkeletalMeshGenerator.Benchmark.BoneTransformExtractor",
+	RUNTIME_GENERATOR_BENCHMARK_FLAGS)
+
+void FRuntimeSkeletonBoneTransformExtractorBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 BonesNum : {64, 256, 1024, 4096})
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%i bones"), BonesNum));
+		OutTestCommands.Add(FString::FromInt(BonesNum));
+	}
+}
+
+bool FRuntimeSkeletonBoneTransformExtractorBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 BonesNum = FCString::Atoi(*Parameters);
+	USkeleton* Skeleton = FRuntimeGeneratorBenchmark::MakeSkeleton(BonesNum);
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+
+	// Pose half of the bones, as the bone overrides of a character.
+	TMap<FName, FTransform> PoseOffsets;
+	for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex += 2)
+	{
+		PoseOffsets.Add(RefSkeleton.GetBoneName(BoneIndex), FTransform(FVector(1.0, 0.0, 0.0)));
+	}
+
+	FVector Checksum = FVector::ZeroVector;
+	const FRuntimeGeneratorBenchmarkResult Result = FRuntimeGeneratorBenchmark::Measure(Iterations, [&]()
+	{
+		const FRuntimeSkeletonBoneTransformExtractor Extractor(RefSkeleton, PoseOffsets);
+		for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex += 1)
+		{
+			Checksum += Extractor.GetGlobalTransform(BoneIndex).GetOrigin();
+		}
+	});
+
+	TestFalse(TEXT("The transforms are valid"), Checksum.ContainsNaN());
+	FRuntimeGeneratorBenchmark::Report(*this, Parameters, Result, BonesNum, TEXT("bones"));
+	return true;
+}
+
+#endif
@@ -0,0 +1,289 @@
+#include "RuntimeSkeletalMeshCache.h"
+
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Hash/xxhash.h"
+#include "Materials/MaterialInterface.h"
+
+namespace
+{
+	template<typename T>
+	void HashArray(FXxHash64Builder& Builder, const TArray<T>& Array)
+	{
+		const int32 Num = Array.Num();
+		Builder.Update(&Num, sizeof(Num));
+		Builder.Update(Array.GetData(), Array.Num() * sizeof(T));
+	}
+
+	template<typename T>
+	void HashValue(FXxHash64Builder& Builder, const T& Value)
+	{
+		Builder.Update(&Value, sizeof(T));
+	}
+
+	void HashSurface(FXxHash64Builder& Builder, const FPackedMeshSurface& Surface)
+	{
+		HashValue(Builder, Surface.MaterialIndex);
+		HashValue(Builder, Surface.UVChannels);
+		HashValue(Builder, Surface.InfluenceSlots);
+		HashArray(Builder, Surface.Indices);
+		HashArray(Builder, Surface.Vertices);
+		HashArray(Builder, Surface.Tangents);
+		HashArray(Builder, Surface.Normals);
+		HashArray(Builder, Surface.Uvs);
+		HashArray(Builder, Surface.Colors);
+		HashArray(Builder, Surface.FlipBinormalSigns);
+		HashArray(Builder, Surface.InfluenceBones);
+		HashArray(Builder, Surface.InfluenceWeights);
+	}
+
+	void HashSurface(FXxHash64Builder& Builder, const FMeshSurface& Surface)
+	{
+		HashValue(Builder, Surface.MaterialIndex);
+		HashArray(Builder, Surface.Indices);
+		HashArray(Builder, Surface.Vertices);
+		HashArray(Builder, Surface.Tangents);
+		HashArray(Builder, Surface.Normals);
+		HashArray(Builder, Surface.Colors);
+		HashArray(Builder, Surface.FlipBinormalSigns);
+		for (const TArray<FVector2D>& Uvs : Surface.Uvs)
+		{
+			HashArray(Builder, Uvs);
+		}
+		for (const TArray<FRawBoneInfluence>& Influences : Surface.BoneInfluences)
+		{
+			HashValue(Builder, Influences.Num());
+			for (const FRawBoneInfluence& Influence : Influences)
+			{
+				HashValue(Builder, Influence.VertexIndex);
+				HashValue(Builder, Influence.BoneIndex);
+				HashValue(Builder, Influence.Weight);
+			}
+		}
+	}
+
+	template<typename FSurface>
+	uint64 ComputeKey_Internal(
+		const USkeleton* BaseSkeleton,
+		const TArray<FSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess,
+		const TMap<FName, FTransform>& BoneTransformsOverride)
+	{
+		FXxHash64Builder Builder;
+
+		if (BaseSkeleton)
+		{
+			HashValue(Builder, BaseSkeleton->GetGuid());
+		}
+		HashValue(Builder, bNeedCPUAccess);
+
+		HashValue(Builder, SurfacesMaterial.Num());
+		for (const UMaterialInterface* Material : SurfacesMaterial)
+		{
+			// The name is hashed too, so a new material allocated at the address of
+			// a destroyed one doesn't match.
+			HashValue(Builder, Material);
+			const uint32 MaterialNameHash = Material ? GetTypeHash(Material->GetFName()) : 0;
+			HashValue(Builder, MaterialNameHash);
+		}
+
+		// The `TMap` order depends on the insertion order, so combine the
+		// overrides in an order independent way.
+		uint64 OverridesHash = 0;
+		for (const TPair<FName, FTransform>& Override : BoneTransformsOverride)
+		{
+			FXxHash64Builder OverrideBuilder;
+			HashValue(OverrideBuilder, GetTypeHash(Override.Key));
+			const FTransform3f Transform(Override.Value);
+			HashValue(OverrideBuilder, Transform.GetTranslation());
+			HashValue(OverrideBuilder, Transform.GetRotation());
+			HashValue(OverrideBuilder, Transform.GetScale3D());
+			OverridesHash += OverrideBuilder.Finalize().Hash;
+		}
+		HashValue(Builder, OverridesHash);
+
+		HashValue(Builder, Surfaces.Num());
+		for (const FSurface& Surface : Surfaces)
+		{
+			HashSurface(Builder, Surface);
+		}
+
+		return Builder.Finalize().Hash;
+	}
+}
+
+FRuntimeSkeletalMeshCache::FRuntimeSkeletalMeshCache(const SIZE_T InMaxMemoryBytes)
+	: MaxMemoryBytes(InMaxMemoryBytes)
+{
+}
+
+USkeletalMesh* FRuntimeSkeletalMeshCache::FindOrGenerate(
+	USkeleton* BaseSkeleton,
+	const TArray<FMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride)
+{
+	return FindOrGenerate_Internal(BaseSkeleton, Surfaces, SurfacesMaterial, bNeedCPUAccess, BoneTransformsOverride);
+}
+
+USkeletalMesh* FRuntimeSkeletalMeshCache::FindOrGenerate(
+	USkeleton* BaseSkeleton,
+	const TArray<FPackedMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride)
+{
+	return FindOrGenerate_Internal(BaseSkeleton, Surfaces, SurfacesMaterial, bNeedCPUAccess, BoneTransformsOverride);
+}
+
+template<typename FSurface>
+USkeletalMesh* FRuntimeSkeletalMeshCache::FindOrGenerate_Internal(
+	USkeleton* BaseSkeleton,
+	const TArray<FSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride)
+{
+	if (!BaseSkeleton)
+	{
+		return nullptr;
+	}
+
+	const uint64 Key = ComputeKey(BaseSkeleton, Surfaces, SurfacesMaterial, bNeedCPUAccess, BoneTransformsOverride);
+	if (USkeletalMesh* CachedSkeletalMesh = Find(Key))
+	{
+		return CachedSkeletalMesh;
+	}
+
+	// Note: we do not pass anything so the skeletal mesh is transient and
+	// destroyed when the play session end.
+	USkeletalMesh* SkeletalMesh = NewObject<USkeletalMesh>();
+	SkeletalMesh->SetRefSkeleton(BaseSkeleton->GetReferenceSkeleton());
+	SkeletalMesh->SetSkeleton(BaseSkeleton);
+
+	if (!FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(
+		SkeletalMesh,
+		Surfaces,
+		SurfacesMaterial,
+		bNeedCPUAccess,
+		BoneTransformsOverride))
+	{
+		return nullptr;
+	}
+
+	Add(Key, SkeletalMesh);
+	return SkeletalMesh;
+}
+
+USkeletalMesh* FRuntimeSkeletalMeshCache::Find(const uint64 Key)
+{
+	check(IsInGameThread());
+
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	USkeletalMesh* SkeletalMesh = Entry->SkeletalMesh.Get();
+	if (!SkeletalMesh)
+	{
+		// Nothing uses this mesh anymore.
+		MemoryBytes -= Entry->MemoryBytes;
+		Entries.Remove(Key);
+		return nullptr;
+	}
+
+	UseCounter += 1;
+	Entry->LastUsed = UseCounter;
+	return SkeletalMesh;
+}
+
+void FRuntimeSkeletalMeshCache::Add(const uint64 Key, USkeletalMesh* SkeletalMesh)
+{
+	check(IsInGameThread());
+
+	if (const FEntry* OldEntry = Entries.Find(Key))
+	{
+		MemoryBytes -= OldEntry->MemoryBytes;
+	}
+
+	UseCounter += 1;
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.SkeletalMesh = SkeletalMesh;
+	Entry.MemoryBytes = SkeletalMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	Entry.LastUsed = UseCounter;
+	MemoryBytes += Entry.MemoryBytes;
+
+	Evict();
+}
+
+void FRuntimeSkeletalMeshCache::Evict()
+{
+	check(IsInGameThread());
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().SkeletalMesh.IsValid())
+		{
+			MemoryBytes -= It.Value().MemoryBytes;
+			It.RemoveCurrent();
+		}
+	}
+
+	if (MemoryBytes <= MaxMemoryBytes)
+	{
+		return;
+	}
+
+	// Drop the least recently used meshes first. The meshes still referenced
+	// elsewhere stay alive, they are just not shared anymore.
+	Entries.ValueSort([](const FEntry& A, const FEntry& B)
+	{
+		return A.LastUsed < B.LastUsed;
+	});
+	for (auto It = Entries.CreateIterator(); It && MemoryBytes > MaxMemoryBytes; ++It)
+	{
+		MemoryBytes -= It.Value().MemoryBytes;
+		It.RemoveCurrent();
+	}
+}
+
+void FRuntimeSkeletalMeshCache::Empty()
+{
+	Entries.Empty();
+	MemoryBytes = 0;
+}
+
+int32 FRuntimeSkeletalMeshCache::Num() const
+{
+	return Entries.Num();
+}
+
+SIZE_T FRuntimeSkeletalMeshCache::GetMemoryBytes() const
+{
+	return MemoryBytes;
+}
+
+uint64 FRuntimeSkeletalMeshCache::ComputeKey(
+	const USkeleton* BaseSkeleton,
+	const TArray<FMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride)
+{
+	return ComputeKey_Internal(BaseSkeleton, Surfaces, SurfacesMaterial, bNeedCPUAccess, BoneTransformsOverride);
+}
+
+uint64 FRuntimeSkeletalMeshCache::ComputeKey(
+	const USkeleton* BaseSkeleton,
+	const TArray<FPackedMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride)
+{
+	return ComputeKey_Internal(BaseSkeleton, Surfaces, SurfacesMaterial, bNeedCPUAccess, BoneTransformsOverride);
+}
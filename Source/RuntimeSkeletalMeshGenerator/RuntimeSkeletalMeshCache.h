@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeSkeletalMeshGenerator.h"
+
+class USkeleton;
+class USkeletalMesh;
+class UMaterialInterface;
+
+/// Cache of the generated `USkeletalMesh`, keyed by the hash of everything used
+/// to generate it: surfaces, materials, skeleton and bone overrides.
+/// The same surfaces submitted twice share the same `USkeletalMesh`, so the
+/// second generation is just a lookup.
+///
+/// The cache keeps only weak references: a mesh is evicted as soon as nothing
+/// else uses it. On top of that, the least recently used meshes are evicted once
+/// the memory of the cached meshes exceeds `MaxMemoryBytes`.
+/// Note: This class must be used from the game thread.
+class RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshCache
+{
+	struct FEntry
+	{
+		TWeakObjectPtr<USkeletalMesh> SkeletalMesh;
+		SIZE_T MemoryBytes = 0;
+		uint64 LastUsed = 0;
+	};
+
+	TMap<uint64, FEntry> Entries;
+	SIZE_T MaxMemoryBytes;
+	SIZE_T MemoryBytes = 0;
+	uint64 UseCounter = 0;
+
+public:
+	explicit FRuntimeSkeletalMeshCache(const SIZE_T InMaxMemoryBytes = 256 * 1024 * 1024);
+
+	/// Returns the cached `USkeletalMesh` generated with these parameters, or
+	/// generates and caches a new one. Returns `nullptr` if the generation fails.
+	USkeletalMesh* FindOrGenerate(
+		USkeleton* BaseSkeleton,
+		const TArray<FMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>());
+
+	/// Packed surfaces version of `FindOrGenerate`.
+	USkeletalMesh* FindOrGenerate(
+		USkeleton* BaseSkeleton,
+		const TArray<FPackedMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>());
+
+	/// Returns the cached `USkeletalMesh` with this key, if any.
+	USkeletalMesh* Find(const uint64 Key);
+
+	/// Caches the `SkeletalMesh` with this key.
+	void Add(const uint64 Key, USkeletalMesh* SkeletalMesh);
+
+	/// Removes the `USkeletalMesh` that are not used anymore, then the least
+	/// recently used ones until the memory is under the limit.
+	void Evict();
+
+	void Empty();
+
+	int32 Num() const;
+
+	SIZE_T GetMemoryBytes() const;
+
+	static uint64 ComputeKey(
+		const USkeleton* BaseSkeleton,
+		const TArray<FMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess,
+		const TMap<FName, FTransform>& BoneTransformsOverride);
+
+	static uint64 ComputeKey(
+		const USkeleton* BaseSkeleton,
+		const TArray<FPackedMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess,
+		const TMap<FName, FTransform>& BoneTransformsOverride);
+
+private:
+	template<typename FSurface>
+	USkeletalMesh* FindOrGenerate_Internal(
+		USkeleton* BaseSkeleton,
+		const TArray<FSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess,
+		const TMap<FName, FTransform>& BoneTransformsOverride);
+};
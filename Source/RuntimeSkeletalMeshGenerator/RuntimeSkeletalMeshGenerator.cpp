@@ -11,10 +11,26 @@
 /* `USkeletalMeshComponent`.                                                  */
 /******************************************************************************/
 #include "RuntimeSkeletalMeshGenerator.h"
-
+#include "RuntimeSkeletalMeshCache.h"
+#include "RuntimeSkeletalMeshPool.h"
+#include "RuntimeSkeletalMeshView.h"
+
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
 #include "Engine/SkeletalMeshLODSettings.h"
 #include "Engine/SkinnedAssetCommon.h"
+#include "GPUSkinVertexFactory.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Rendering/SkeletalMeshModel.h"
+#include "RenderingThread.h"
+
+#include <atomic>
 
 void FRuntimeSkeletalMeshGeneratorModule::StartupModule()
 {
@@ -26,584 +42,4026 @@ void FRuntimeSkeletalMeshGeneratorModule::ShutdownModule()
 
 IMPLEMENT_MODULE(FRuntimeSkeletalMeshGeneratorModule, RuntimeSkeletalMeshGenerator)
 
-bool FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(
-	USkeletalMesh* SkeletalMesh,
-	const TArray<FMeshSurface>& Surfaces,
-	const TArray<UMaterialInterface*>& SurfacesMaterial,
-	const bool bNeedCPUAccess,
-	const TMap<FName, FTransform>& BoneTransformsOverride)
+DECLARE_STATS_GROUP(TEXT("RuntimeSkeletalMeshGenerator"), STATGROUP_RuntimeSkeletalMeshGenerator, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Count"), STAT_RuntimeSkeletalMesh_Count, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("Pack"), STAT_RuntimeSkeletalMesh_Pack, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("Indices"), STAT_RuntimeSkeletalMesh_Indices, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("BoneMap"), STAT_RuntimeSkeletalMesh_BoneMap, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("Optimize"), STAT_RuntimeSkeletalMesh_Optimize, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("Weld"), STAT_RuntimeSkeletalMesh_Weld, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("DuplicatedVertices"), STAT_RuntimeSkeletalMesh_DuplicatedVertices, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("Merge"), STAT_RuntimeSkeletalMesh_Merge, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("MergeMeshes"), STAT_RuntimeSkeletalMesh_MergeMeshes, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("ImportData"), STAT_RuntimeSkeletalMesh_ImportData, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("IndexBuffer"), STAT_RuntimeSkeletalMesh_IndexBuffer, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("VertexBuffers"), STAT_RuntimeSkeletalMesh_VertexBuffers, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("SkinWeights"), STAT_RuntimeSkeletalMesh_SkinWeights, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("PostLoad"), STAT_RuntimeSkeletalMesh_PostLoad, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_CYCLE_STAT(TEXT("Decompose"), STAT_RuntimeSkeletalMesh_Decompose, STATGROUP_RuntimeSkeletalMeshGenerator);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vertices"), STAT_RuntimeSkeletalMesh_Vertices, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Indices"), STAT_RuntimeSkeletalMesh_IndicesNum, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sections"), STAT_RuntimeSkeletalMesh_Sections, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Section Bones"), STAT_RuntimeSkeletalMesh_SectionBones, STATGROUP_RuntimeSkeletalMeshGenerator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Allocated Bytes"), STAT_RuntimeSkeletalMesh_AllocatedBytes, STATGROUP_RuntimeSkeletalMeshGenerator);
+
+namespace
 {
-	// Waits the rendering thread has done.
-	FlushRenderingCommands();
+	/// The data returned by `FRuntimeSkeletalMeshGenerator::GetStats`; the
+	/// generation can run on many threads at once, so it's atomic.
+	struct FAtomicGeneratorStats
+	{
+		std::atomic<int64> BuiltLODs{0};
+		std::atomic<int64> CommittedMeshes{0};
+		std::atomic<int64> DecomposedMeshes{0};
+
+		std::atomic<uint64> CountCycles{0};
+		std::atomic<uint64> PackCycles{0};
+		std::atomic<uint64> IndicesCycles{0};
+		std::atomic<uint64> BoneMapCycles{0};
+		std::atomic<uint64> OptimizeCycles{0};
+		std::atomic<uint64> WeldCycles{0};
+		std::atomic<uint64> DuplicatedVerticesCycles{0};
+		std::atomic<uint64> MergeCycles{0};
+		std::atomic<uint64> MergeMeshesCycles{0};
+		std::atomic<uint64> ImportDataCycles{0};
+		std::atomic<uint64> IndexBufferCycles{0};
+		std::atomic<uint64> VertexBuffersCycles{0};
+		std::atomic<uint64> SkinWeightsCycles{0};
+		std::atomic<uint64> PostLoadCycles{0};
+		std::atomic<uint64> DecomposeCycles{0};
+
+		std::atomic<int64> Vertices{0};
+		std::atomic<int64> Indices{0};
+		std::atomic<int64> Sections{0};
+		std::atomic<int64> SectionBones{0};
+		std::atomic<int64> AllocatedBytes{0};
+	};
+
+	FAtomicGeneratorStats GeneratorStats;
+
+	/// Adds the cycles spent in the scope to `Cycles`.
+	struct FScopedPhaseCycles
+	{
+		std::atomic<uint64>& Cycles;
+		const uint64 StartCycles;
 
-	constexpr int32 LODIndex = 0;
+		explicit FScopedPhaseCycles(std::atomic<uint64>& InCycles)
+			: Cycles(InCycles)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+		}
 
-#if WITH_EDITORONLY_DATA
-	FSkeletalMeshImportData ImportedModelData;
-#endif
+		~FScopedPhaseCycles()
+		{
+			Cycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+	};
+}
 
-	TArray<uint32> SurfaceVertexOffsets;
-	TArray<uint32> SurfaceIndexOffsets;
-	SurfaceVertexOffsets.SetNum(Surfaces.Num());
-	SurfaceIndexOffsets.SetNum(Surfaces.Num());
+/// Measures a generation phase, which is then visible with
+/// `stat RuntimeSkeletalMeshGenerator`, in Unreal Insights and in
+/// `FRuntimeSkeletalMeshGenerator::GetStats`.
+#define RUNTIME_SKELETAL_MESH_PHASE(Phase) \
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeSkeletalMesh_##Phase); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(RuntimeSkeletalMesh_##Phase); \
+	const FScopedPhaseCycles ANONYMOUS_VARIABLE(PhaseCycles)(GeneratorStats.Phase##Cycles)
 
-	bool bUse16BitBoneIndex = false;
-	int32 MaxBoneInfluences = 0;
-	const int32 UVCount = Surfaces.Num() > 0 ? (Surfaces[0].Uvs.Num() > 0 ? Surfaces[0].Uvs[0].Num() : 0) : 0;
+namespace
+{
+	/// The amount of vertices, or indices, processed by a single parallel task.
+	constexpr int32 ElementsPerTask = 16 * 1024;
 
-	// Collect all the vertices and index for each surface.
-	TArray<FStaticMeshBuildVertex> StaticVertices;
-	TArray<FVector> Vertices;
-	TArray<uint32> Indices;
-	TArray<uint32> VertexSurfaceIndex;
+	/// A range of elements of a surface, processed by a single parallel task.
+	struct FSurfaceTaskRange
 	{
-		int MaxBoneIndex = 0;
-		// First count all the vertices.
-		uint32 VerticesCount = 0;
-		uint32 IndicesCount = 0;
-		for (const FMeshSurface& Surface : Surfaces)
+		int32 SurfaceIndex;
+		int32 Begin;
+		int32 End;
+	};
+
+	/// Splits the elements of each surface in ranges of at most `ElementsPerTask`
+	/// elements, so big and small surfaces are spread evenly across the workers.
+	template<typename FGetElementsNum>
+	TArray<FSurfaceTaskRange> MakeSurfaceTaskRanges(const int32 SurfacesNum, FGetElementsNum&& GetElementsNum)
+	{
+		TArray<FSurfaceTaskRange> Ranges;
+		for (int32 SurfaceIndex = 0; SurfaceIndex < SurfacesNum; SurfaceIndex += 1)
 		{
-			VerticesCount += Surface.Vertices.Num();
-			IndicesCount += Surface.Indices.Num();
-
-			for (const auto& Influences : Surface.BoneInfluences)
+			const int32 ElementsNum = GetElementsNum(SurfaceIndex);
+			for (int32 Begin = 0; Begin < ElementsNum; Begin += ElementsPerTask)
 			{
-				MaxBoneInfluences = FMath::Max(Influences.Num(), MaxBoneInfluences);
-				for (const auto& Influence : Influences)
-				{
-					MaxBoneIndex = FMath::Max(Influence.BoneIndex, MaxBoneIndex);
-				}
+				Ranges.Add({SurfaceIndex, Begin, FMath::Min(Begin + ElementsPerTask, ElementsNum)});
 			}
+		}
+		return Ranges;
+	}
 
-#if WITH_EDITOR
-			// Make sure all the surfaces and all the vertices have the same amount of
-			// UVs.
-			for (const TArray<FVector2D> Uvs : Surface.Uvs)
-			{
-				check(UVCount == Uvs.Num());
-			}
-#endif
+	/// Computes the vertices and indices count of each surface of `LODData`,
+	/// from the offset of the surface that follows it in the buffers.
+	void GetSurfacesSize(const FRuntimeSkeletalMeshLODData& LODData, TArray<uint32>& OutVerticesNum, TArray<uint32>& OutIndicesNum)
+	{
+		const int32 SurfacesNum = LODData.SurfaceVertexOffsets.Num();
+		OutVerticesNum.SetNumUninitialized(SurfacesNum);
+		OutIndicesNum.SetNumUninitialized(SurfacesNum);
+		for (int32 I = 0; I < SurfacesNum; I += 1)
+		{
+			const int32 SurfaceIndex = LODData.SurfaceOrder.Num() > 0 ? LODData.SurfaceOrder[I] : I;
+			const int32 NextSurfaceIndex = I + 1 >= SurfacesNum ? INDEX_NONE : LODData.SurfaceOrder.Num() > 0 ? LODData.SurfaceOrder[I + 1] : I + 1;
+			OutVerticesNum[SurfaceIndex] =
+				(NextSurfaceIndex != INDEX_NONE ? LODData.SurfaceVertexOffsets[NextSurfaceIndex] : LODData.StaticVertices.Num())
+				- LODData.SurfaceVertexOffsets[SurfaceIndex];
+			OutIndicesNum[SurfaceIndex] =
+				(NextSurfaceIndex != INDEX_NONE ? LODData.SurfaceIndexOffsets[NextSurfaceIndex] : LODData.Indices.Num())
+				- LODData.SurfaceIndexOffsets[SurfaceIndex];
 		}
+	}
 
-		bUse16BitBoneIndex = MaxBoneIndex <= MAX_uint16;
+	/// Sorts the influences by weight, drops the ones below `MinWeight` and
+	/// the ones exceeding `MaxInfluences`, then normalizes the kept weights so
+	/// they sum exactly to 65535.
+	void SanitizeBoneWeights(FSkinWeightInfo& Weight, const int32 MaxInfluences, const float MinWeight)
+	{
+		int32 Order[MAX_TOTAL_INFLUENCES];
+		for (int32 I = 0; I < MAX_TOTAL_INFLUENCES; I += 1)
+		{
+			Order[I] = I;
+		}
+		Algo::Sort(Order, [&](const int32 A, const int32 B)
+		{
+			return Weight.InfluenceWeights[A] > Weight.InfluenceWeights[B];
+		});
 
-		StaticVertices.SetNum(VerticesCount);
-		Vertices.SetNum(VerticesCount);
-		VertexSurfaceIndex.SetNum(VerticesCount);
-		Indices.SetNum(IndicesCount);
+		const uint16 MinEncodedWeight = static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(MinWeight, 0.f, 1.f) * 65535.f));
+		const int32 KeptNum = FMath::Clamp(MaxInfluences, 1, MAX_TOTAL_INFLUENCES);
 
-		uint32 VerticesOffset = 0;
-		uint32 IndicesOffset = 0;
-		for (int32 I = 0; I < Surfaces.Num(); I++)
+		FSkinWeightInfo Sorted;
+		FMemory::Memzero(Sorted);
+		uint32 Sum = 0;
+		for (int32 I = 0; I < KeptNum; I += 1)
 		{
-			const FMeshSurface& Surface = Surfaces[I];
-
-			for (int VertexIndex = 0; VertexIndex < Surface.Vertices.Num(); VertexIndex += 1)
+			const uint16 InfluenceWeight = Weight.InfluenceWeights[Order[I]];
+			// Always keep the heaviest influence, so the vertex stays skinned.
+			if (InfluenceWeight == 0 || (I > 0 && InfluenceWeight < MinEncodedWeight))
 			{
-				if (Surface.Colors.Num() > 0)
-				{
-					StaticVertices[VerticesOffset + VertexIndex].Color = Surface.Colors[VertexIndex];
-				}
-				StaticVertices[VerticesOffset + VertexIndex].Position = FVector3f(Surface.Vertices[VertexIndex]);
-				StaticVertices[VerticesOffset + VertexIndex].TangentX = FVector3f(Surface.Tangents[VertexIndex]);
-				StaticVertices[VerticesOffset + VertexIndex].TangentY = FVector3f(FVector::CrossProduct(Surface.Normals[VertexIndex], Surface.Tangents[VertexIndex]) * (Surface.FlipBinormalSigns[VertexIndex] ? -1.0 : 1.0));
-				StaticVertices[VerticesOffset + VertexIndex].TangentZ = FVector3f(Surface.Normals[VertexIndex]);
-				for(int32 UVIndex = 0; UVIndex < UVCount; ++UVIndex)
-				{
-					StaticVertices[VerticesOffset + VertexIndex].UVs[UVIndex] = FVector2f(Surface.Uvs[VertexIndex][UVIndex]);
-				}
-				VertexSurfaceIndex[VerticesOffset + VertexIndex] = I;
+				break;
 			}
+			Sorted.InfluenceBones[I] = Weight.InfluenceBones[Order[I]];
+			Sorted.InfluenceWeights[I] = InfluenceWeight;
+			Sum += InfluenceWeight;
+		}
 
-			FMemory::Memcpy(
-				Vertices.GetData() + VerticesOffset,
-				Surface.Vertices.GetData(),
-				sizeof(FVector) * Surface.Vertices.Num());
+		if (Sum == 0)
+		{
+			// This vertex has no weights, nothing to normalize.
+			Weight = Sorted;
+			return;
+		}
 
-			// Convert the Indices to Global.
-			for (int32 IndicesIndex = 0; IndicesIndex < Surface.Indices.Num(); IndicesIndex++)
+		// Scale, then give the units lost by the rounding to the influences with
+		// the largest remainder.
+		uint32 NormalizedSum = 0;
+		uint32 Remainders[MAX_TOTAL_INFLUENCES] = {};
+		for (int32 I = 0; I < KeptNum; I += 1)
+		{
+			const uint64 Scaled = uint64(Sorted.InfluenceWeights[I]) * 65535;
+			Sorted.InfluenceWeights[I] = Scaled / Sum;
+			Remainders[I] = Scaled % Sum;
+			NormalizedSum += Sorted.InfluenceWeights[I];
+		}
+		for (; NormalizedSum < 65535; NormalizedSum += 1)
+		{
+			int32 Largest = 0;
+			for (int32 I = 1; I < KeptNum; I += 1)
 			{
-				Indices[IndicesOffset + IndicesIndex] = Surface.Indices[IndicesIndex] + VerticesOffset;
+				if (Remainders[I] > Remainders[Largest])
+				{
+					Largest = I;
+				}
 			}
-
-			SurfaceVertexOffsets[I] = VerticesOffset;
-			VerticesOffset += Surface.Vertices.Num();
-
-			SurfaceIndexOffsets[I] = IndicesOffset;
-			IndicesOffset += Surface.Indices.Num();
+			Sorted.InfluenceWeights[Largest] += 1;
+			Remainders[Largest] = 0;
 		}
-	}
 
-#if WITH_EDITORONLY_DATA
-	// Initialize the `ImportModel` this is used by the editor during reload time.
-	ImportedModelData.Points.Empty();
-	ImportedModelData.Points.Append(Vertices);
+		Weight = Sorted;
+	}
 
-	// Existing points map 1:1
-	ImportedModelData.PointToRawMap.AddUninitialized(ImportedModelData.Points.Num());
-	for (int32 i = 0; i < ImportedModelData.Points.Num(); i++)
+	/// Rounds the weights to the 8 bits the skin weight buffer stores, unless it
+	/// uses high precision weights: the missing units go to the influences with
+	/// the largest rounding error, so the weights keep their sum and the
+	/// vertices don't drift. The weights stay in the 0 - 65535 range.
+	void QuantizeBoneWeightsTo8Bit(FSkinWeightInfo& Weight)
 	{
-		ImportedModelData.PointToRawMap[i] = i;
-	}
-	check(ImportedModelData.PointToRawMap.Num() == Vertices.Num());
+		// 65535 / 255: an 8 bits weight `W` is stored as `W * 257`.
+		constexpr uint32 WeightUnit = 257;
+
+		uint32 Sum = 0;
+		for (int32 I = 0; I < MAX_TOTAL_INFLUENCES; I += 1)
+		{
+			Sum += Weight.InfluenceWeights[I];
+		}
+		const uint32 TargetSum = (Sum + WeightUnit / 2) / WeightUnit;
 
+		uint32 QuantizedSum = 0;
+		uint32 Remainders[MAX_TOTAL_INFLUENCES];
+		for (int32 I = 0; I < MAX_TOTAL_INFLUENCES; I += 1)
+		{
+			Remainders[I] = Weight.InfluenceWeights[I] % WeightUnit;
+			Weight.InfluenceWeights[I] = Weight.InfluenceWeights[I] / WeightUnit;
+			QuantizedSum += Weight.InfluenceWeights[I];
+		}
 
-	for (const auto& Surface : Surfaces)
-	{
-		// The assignment of the material here is not necessarily correct. I wonder if an error will occur if the SurfacesMaterial is empty.
-		if (Surface.MaterialIndex >= 0 && Surface.MaterialIndex < SurfacesMaterial.Num())
+		for (; QuantizedSum < TargetSum; QuantizedSum += 1)
 		{
-			if (Surface.MaterialIndex >= ImportedModelData.Materials.Num())
+			int32 Largest = 0;
+			for (int32 I = 1; I < MAX_TOTAL_INFLUENCES; I += 1)
 			{
-				SkeletalMeshImportData::FMaterial& NewMaterial = ImportedModelData.Materials.AddDefaulted_GetRef();
-				NewMaterial.Material = SurfacesMaterial[Surface.MaterialIndex];
-				NewMaterial.MaterialImportName = SurfacesMaterial[Surface.MaterialIndex]->GetFullName();
+				if (Remainders[I] > Remainders[Largest])
+				{
+					Largest = I;
+				}
 			}
+			Weight.InfluenceWeights[Largest] += 1;
+			Remainders[Largest] = 0;
 		}
-	}
 
+		for (int32 I = 0; I < MAX_TOTAL_INFLUENCES; I += 1)
+		{
+			Weight.InfluenceWeights[I] *= WeightUnit;
+			if (Weight.InfluenceWeights[I] == 0)
+			{
+				Weight.InfluenceBones[I] = 0;
+			}
+		}
+	}
 
-	ImportedModelData.Faces.SetNum(Indices.Num() / 3);
-	for (int32 FaceIndex = 0; FaceIndex < ImportedModelData.Faces.Num(); FaceIndex += 1)
+	/// The bytes of each vertex in the `VertexStreams` of `LODData`.
+	uint32 GetTangentsStride(const FRuntimeSkeletalMeshLODData& LODData)
 	{
-		SkeletalMeshImportData::FTriangle& Triangle = ImportedModelData.Faces[FaceIndex];
-
-		const int32 VertexIndex0 = Indices[FaceIndex * 3 + 0];
-		const int32 VertexIndex1 = Indices[FaceIndex * 3 + 1];
-		const int32 VertexIndex2 = Indices[FaceIndex * 3 + 2];
-		Triangle.WedgeIndex[0] = FaceIndex * 3 + 0;
-		Triangle.WedgeIndex[1] = FaceIndex * 3 + 1;
-		Triangle.WedgeIndex[2] = FaceIndex * 3 + 2;
-
-		Triangle.TangentX[0] = StaticVertices[VertexIndex0].TangentX;
-		Triangle.TangentY[0] = StaticVertices[VertexIndex0].TangentY;
-		Triangle.TangentZ[0] = StaticVertices[VertexIndex0].TangentZ;
-
-		Triangle.TangentX[1] = StaticVertices[VertexIndex1].TangentX;
-		Triangle.TangentY[1] = StaticVertices[VertexIndex1].TangentY;
-		Triangle.TangentZ[1] = StaticVertices[VertexIndex1].TangentZ;
+		return LODData.bUseHighPrecisionTangentBasis ? 2 * sizeof(FPackedRGBA16N) : 2 * sizeof(FPackedNormal);
+	}
 
-		Triangle.TangentX[2] = StaticVertices[VertexIndex2].TangentX;
-		Triangle.TangentY[2] = StaticVertices[VertexIndex2].TangentY;
-		Triangle.TangentZ[2] = StaticVertices[VertexIndex2].TangentZ;
+	uint32 GetTexCoordsStride(const FRuntimeSkeletalMeshLODData& LODData)
+	{
+		return LODData.UVCount * (LODData.bUseFullPrecisionUVs ? sizeof(FVector2f) : sizeof(FVector2DHalf));
+	}
 
-		Triangle.MatIndex = VertexSurfaceIndex[VertexIndex0];
-		Triangle.AuxMatIndex = 0;
-		Triangle.SmoothingGroups = 1; // TODO Calculate the smoothing group correctly, otherwise everything will be smooth
+	uint32 GetSkinWeightsStride(const FRuntimeSkeletalMeshLODData& LODData)
+	{
+		const uint32 BoneIndexSize = LODData.bUse16BitBoneIndex ? sizeof(uint16) : sizeof(uint8);
+		const uint32 BoneWeightSize = LODData.bUseHighPrecisionBoneWeights ? sizeof(uint16) : sizeof(uint8);
+		return LODData.MaxBoneInfluences * (BoneIndexSize + BoneWeightSize);
 	}
 
-	ImportedModelData.Wedges.SetNum(ImportedModelData.Faces.Num() * 3);
-	for (int32 FaceIndex = 0; FaceIndex < ImportedModelData.Faces.Num(); FaceIndex += 1)
+	/// Encodes the `TangentX` and the `TangentZ`, with the binormal sign in W,
+	/// as `FRuntimeSkeletalMeshVertexStreams::Tangents` stores them.
+	void EncodeTangents(const FVector4f& TangentX, const FVector4f& TangentZ, const bool bHighPrecision, uint8* OutData)
 	{
-		for (int32 i = 0; i < 3; i += 1)
+		if (bHighPrecision)
+		{
+			reinterpret_cast<FPackedRGBA16N*>(OutData)[0] = FPackedRGBA16N(TangentX);
+			reinterpret_cast<FPackedRGBA16N*>(OutData)[1] = FPackedRGBA16N(TangentZ);
+		}
+		else
 		{
-			const int32 WedgeIndex = FaceIndex * 3 + i;
-			const int32 VertexIndex = Indices[WedgeIndex];
+			reinterpret_cast<FPackedNormal*>(OutData)[0] = FPackedNormal(TangentX);
+			reinterpret_cast<FPackedNormal*>(OutData)[1] = FPackedNormal(TangentZ);
+		}
+	}
 
-			ImportedModelData.Wedges[WedgeIndex].VertexIndex = VertexIndex;
-			for (int32 UVIndex = 0; UVIndex < FMath::Min<int32>(MAX_TEXCOORDS, MAX_STATIC_TEXCOORDS); ++UVIndex)
-			{
-				ImportedModelData.Wedges[WedgeIndex].UVs[UVIndex] = StaticVertices[VertexIndex].UVs[UVIndex];
-			}
-			ImportedModelData.Wedges[WedgeIndex].MatIndex = VertexSurfaceIndex[VertexIndex];
-			ImportedModelData.Wedges[WedgeIndex].Color = StaticVertices[VertexIndex].Color;
-			ImportedModelData.Wedges[WedgeIndex].Reserved = 0;
+	void EncodeTexCoord(const FVector2f& UV, const bool bFullPrecision, uint8* OutData)
+	{
+		if (bFullPrecision)
+		{
+			*reinterpret_cast<FVector2f*>(OutData) = UV;
+		}
+		else
+		{
+			*reinterpret_cast<FVector2DHalf*>(OutData) = FVector2DHalf(UV);
 		}
 	}
 
+	/// Encodes the first `InfluencesNum` influences of `Weight` as
+	/// `FRuntimeSkeletalMeshVertexStreams::SkinWeights` stores them. The 8 bits
+	/// weights are rounded: quantize them first to keep their sum.
+	void EncodeSkinWeight(const FSkinWeightInfo& Weight, const int32 InfluencesNum, const bool b16BitBoneIndex, const bool b16BitBoneWeight, uint8* OutData)
 	{
-		const int32 BoneNum = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawBoneNum();
-		SkeletalMeshImportData::FBone DefaultBone;
-		DefaultBone.Name = FString(TEXT(""));
-		DefaultBone.Flags = 0;
-		DefaultBone.NumChildren = 0;
-		DefaultBone.ParentIndex = INDEX_NONE;
-		DefaultBone.BonePos.Transform.SetIdentity();
-		DefaultBone.BonePos.Length = 0.0;
-		DefaultBone.BonePos.XSize = 1.0;
-		DefaultBone.BonePos.YSize = 1.0;
-		DefaultBone.BonePos.ZSize = 1.0;
-		ImportedModelData.RefBonesBinary.Init(DefaultBone, BoneNum);
-		for (int32 i = 0; i < BoneNum; i += 1)
+		for (int32 I = 0; I < InfluencesNum; I += 1)
 		{
-			ImportedModelData.RefBonesBinary[i].Name = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetBoneName(i).ToString();
-			ImportedModelData.RefBonesBinary[i].ParentIndex = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetParentIndex(i);
-			if (ImportedModelData.RefBonesBinary[i].ParentIndex != INDEX_NONE)
+			if (b16BitBoneIndex)
+			{
+				reinterpret_cast<uint16*>(OutData)[I] = Weight.InfluenceBones[I];
+			}
+			else
 			{
-				// Increase parent children count by 1
-				ImportedModelData.RefBonesBinary[ImportedModelData.RefBonesBinary[i].ParentIndex].NumChildren += 1;
+				OutData[I] = static_cast<uint8>(Weight.InfluenceBones[I]);
 			}
 		}
 
-		// At this point it's certain all the bones are initialized, finish the process
-		// by setting the local transform.
-		for (int32 i = 0; i < BoneNum; i += 1)
+		uint8* WeightsData = OutData + InfluencesNum * (b16BitBoneIndex ? sizeof(uint16) : sizeof(uint8));
+		for (int32 I = 0; I < InfluencesNum; I += 1)
 		{
-			// Relative to its parent.
-			const FTransform* TransformOverride = BoneTransformsOverride.Find(SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetBoneName(i));
-			if (TransformOverride != nullptr)
+			if (b16BitBoneWeight)
 			{
-				
-				ImportedModelData.RefBonesBinary[i].BonePos.Transform = FTransform3f(*TransformOverride);
+				reinterpret_cast<uint16*>(WeightsData)[I] = Weight.InfluenceWeights[I];
 			}
 			else
 			{
-				ImportedModelData.RefBonesBinary[i].BonePos.Transform = FTransform3f(SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawRefBonePose()[i]);
+				WeightsData[I] = static_cast<uint8>((Weight.InfluenceWeights[I] + 128) / 257);
 			}
-			// Set the Bone Length.
-			ImportedModelData.RefBonesBinary[i].BonePos.Length = ImportedModelData.RefBonesBinary[i].BonePos.Transform.GetLocation().Size();
 		}
 	}
+
+	/// The inverse of `EncodeSkinWeight`: the weights are in the 0 - 65535 range.
+	FSkinWeightInfo DecodeSkinWeight(const uint8* Data, const int32 InfluencesNum, const bool b16BitBoneIndex, const bool b16BitBoneWeight)
+	{
+		FSkinWeightInfo Weight;
+		FMemory::Memzero(Weight);
+		for (int32 I = 0; I < InfluencesNum; I += 1)
+		{
+			Weight.InfluenceBones[I] = b16BitBoneIndex ? reinterpret_cast<const uint16*>(Data)[I] : Data[I];
+		}
+
+		const uint8* WeightsData = Data + InfluencesNum * (b16BitBoneIndex ? sizeof(uint16) : sizeof(uint8));
+		for (int32 I = 0; I < InfluencesNum; I += 1)
+		{
+			Weight.InfluenceWeights[I] = b16BitBoneWeight ? reinterpret_cast<const uint16*>(WeightsData)[I] : uint16(WeightsData[I]) * 257;
+		}
+		return Weight;
+	}
+
+#if WITH_EDITORONLY_DATA
+	/// Fills the `StaticVertices` and the `Weights` from the `VertexStreams`:
+	/// the editor model is built from them.
+	void DecodeVertexStreams(FRuntimeSkeletalMeshLODData& LODData)
+	{
+		const FRuntimeSkeletalMeshVertexStreams& Streams = LODData.VertexStreams;
+		const uint32 TangentsStride = GetTangentsStride(LODData);
+		const uint32 TexCoordsStride = GetTexCoordsStride(LODData);
+		const uint32 SkinWeightsStride = GetSkinWeightsStride(LODData);
+		const uint32 TexCoordSize = LODData.bUseFullPrecisionUVs ? sizeof(FVector2f) : sizeof(FVector2DHalf);
+
+		LODData.StaticVertices.SetNumZeroed(Streams.Positions.Num());
+		LODData.Weights.SetNumUninitialized(Streams.Positions.Num());
+		ParallelFor(Streams.Positions.Num(), [&](const int32 VertexIndex)
+		{
+			FStaticMeshBuildVertex& StaticVertex = LODData.StaticVertices[VertexIndex];
+			StaticVertex.Position = Streams.Positions[VertexIndex];
+
+			const uint8* TangentsData = Streams.Tangents.GetData() + VertexIndex * TangentsStride;
+			const FVector4f TangentX = LODData.bUseHighPrecisionTangentBasis
+				? reinterpret_cast<const FPackedRGBA16N*>(TangentsData)[0].ToFVector4f()
+				: reinterpret_cast<const FPackedNormal*>(TangentsData)[0].ToFVector4f();
+			const FVector4f TangentZ = LODData.bUseHighPrecisionTangentBasis
+				? reinterpret_cast<const FPackedRGBA16N*>(TangentsData)[1].ToFVector4f()
+				: reinterpret_cast<const FPackedNormal*>(TangentsData)[1].ToFVector4f();
+			StaticVertex.TangentX = FVector3f(TangentX);
+			StaticVertex.TangentZ = FVector3f(TangentZ);
+			StaticVertex.TangentY = FVector3f::CrossProduct(StaticVertex.TangentZ, StaticVertex.TangentX) * TangentZ.W;
+
+			for (int32 UVIndex = 0; UVIndex < LODData.UVCount; UVIndex += 1)
+			{
+				const uint8* UVData = Streams.TexCoords.GetData() + VertexIndex * TexCoordsStride + UVIndex * TexCoordSize;
+				StaticVertex.UVs[UVIndex] = LODData.bUseFullPrecisionUVs
+					? *reinterpret_cast<const FVector2f*>(UVData)
+					: FVector2f(*reinterpret_cast<const FVector2DHalf*>(UVData));
+			}
+			StaticVertex.Color = Streams.Colors.Num() > 0 ? Streams.Colors[VertexIndex] : FColor::White;
+
+			LODData.Weights[VertexIndex] = DecodeSkinWeight(
+				Streams.SkinWeights.GetData() + VertexIndex * SkinWeightsStride,
+				LODData.MaxBoneInfluences,
+				LODData.bUse16BitBoneIndex,
+				LODData.bUseHighPrecisionBoneWeights);
+		});
+	}
 #endif
 
-	// Unreal doesn't support more than `MAX_TOTAL_INFLUENCES` BoneInfluences.
-	check(MaxBoneInfluences <= MAX_TOTAL_INFLUENCES);
+	/// Splits the sections that reference more than `MaxBonesPerSection` bones.
+	/// The triangles are distributed, in order, to as many sections as needed;
+	/// the vertices shared between two split sections are duplicated, since each
+	/// section needs its own vertex range.
+	void SplitSectionsByBoneLimit(FRuntimeSkeletalMeshLODData& LODData, const int32 BoneNum, const int32 MaxBonesPerSection)
+	{
+		TArray<FStaticMeshBuildVertex> NewStaticVertices;
+		TArray<FSkinWeightInfo> NewWeights;
+		TArray<uint32> NewIndices;
+		TArray<FRuntimeSkeletalMeshSection> NewSections;
+		TArray<uint32> NewSourceVertices;
+		NewStaticVertices.Reserve(LODData.StaticVertices.Num());
+		NewWeights.Reserve(LODData.Weights.Num());
+		NewIndices.Reserve(LODData.Indices.Num());
+		NewSections.Reserve(LODData.Sections.Num());
+		NewSourceVertices.Reserve(LODData.StaticVertices.Num());
+
+		// Maps the old vertex index to the new one, for the section being built.
+		TArray<int32> VertexRemap;
+		VertexRemap.Init(INDEX_NONE, LODData.StaticVertices.Num());
+
+		// The old vertices used by the section being built.
+		TArray<uint32> SectionOldVertices;
+
+		// Contains, for each bone, the last new section using it.
+		TArray<int32> BoneSection;
+		BoneSection.Init(INDEX_NONE, BoneNum);
+
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			LODData.SurfaceVertexOffsets[Section.SurfaceIndex] = NewStaticVertices.Num();
+			LODData.SurfaceIndexOffsets[Section.SurfaceIndex] = NewIndices.Num();
 
-	// Unreal doesn't support more than `MAX_STATIC_TEXCOORDS`.
-	check(UVCount <= MAX_STATIC_TEXCOORDS);
+			if (Section.BoneMap.Num() <= MaxBonesPerSection)
+			{
+				// Nothing to split, just move the section.
+				const int32 NewBaseVertexIndex = NewStaticVertices.Num();
+				NewStaticVertices.Append(LODData.StaticVertices.GetData() + Section.BaseVertexIndex, Section.NumVertices);
+				NewWeights.Append(LODData.Weights.GetData() + Section.BaseVertexIndex, Section.NumVertices);
+				for (uint32 I = 0; I < Section.NumVertices; I += 1)
+				{
+					NewSourceVertices.Add(LODData.SourceVertices.Num() > 0 ? LODData.SourceVertices[Section.BaseVertexIndex + I] : I);
+				}
 
-	// Populate Arrays step.
-	SkeletalMesh->AllocateResourceForRendering();
-	FSkeletalMeshRenderData* MeshRenderData = SkeletalMesh->GetResourceForRendering();
+				FRuntimeSkeletalMeshSection& NewSection = NewSections.Add_GetRef(Section);
+				NewSection.BaseVertexIndex = NewBaseVertexIndex;
+				NewSection.BaseIndex = NewIndices.Num();
+				for (uint32 I = 0; I < Section.NumTriangles * 3; I += 1)
+				{
+					NewIndices.Add(LODData.Indices[Section.BaseIndex + I] - Section.BaseVertexIndex + NewBaseVertexIndex);
+				}
+				continue;
+			}
 
-	auto LODMeshRenderData = new FSkeletalMeshLODRenderData;
-	if (!LODMeshRenderData)
-		return false;
-	MeshRenderData->LODRenderData.Add(LODMeshRenderData);
+			uint32 TriangleIndex = 0;
+			while (TriangleIndex < Section.NumTriangles)
+			{
+				const int32 NewSectionIndex = NewSections.Num();
+				FRuntimeSkeletalMeshSection& NewSection = NewSections.Add_GetRef(Section);
+				NewSection.BaseVertexIndex = NewStaticVertices.Num();
+				NewSection.NumVertices = 0;
+				NewSection.BaseIndex = NewIndices.Num();
+				NewSection.NumTriangles = 0;
+				NewSection.BoneMap.Reset();
+
+				for (; TriangleIndex < Section.NumTriangles; TriangleIndex += 1)
+				{
+					const uint32* Triangle = LODData.Indices.GetData() + Section.BaseIndex + TriangleIndex * 3;
 
-	SkeletalMesh->ResetLODInfo();
-	FSkeletalMeshLODInfo& MeshLodInfo = SkeletalMesh->AddLODInfo();
-	// These are correct unreal defaults.
-	MeshLodInfo.LODHysteresis = 0.02;
-	MeshLodInfo.ScreenSize = 1.0;
-	MeshLodInfo.bAllowCPUAccess = bNeedCPUAccess;
-	if(bNeedCPUAccess)
-	{
-		MeshLodInfo.SkinCacheUsage = ESkinCacheUsage::Disabled;
-		MeshLodInfo.bHasBeenSimplified = true;
-	}
+					// Collect the bones this triangle would add to the section.
+					TArray<FBoneIndexType, TInlineAllocator<3 * MAX_TOTAL_INFLUENCES>> TriangleBones;
+					for (int32 Corner = 0; Corner < 3; Corner += 1)
+					{
+						const FSkinWeightInfo& Weight = LODData.Weights[Triangle[Corner]];
+						for (int32 I = 0; I < LODData.MaxBoneInfluences; I += 1)
+						{
+							if (Weight.InfluenceWeights[I] > 0 && BoneSection[Weight.InfluenceBones[I]] != NewSectionIndex)
+							{
+								TriangleBones.AddUnique(Weight.InfluenceBones[I]);
+							}
+						}
+					}
 
-	// Set Bounding boxes
-	const FBox BoundingBox(Vertices.GetData(), Vertices.Num());
-	SkeletalMesh->SetImportedBounds(FBoxSphereBounds(BoundingBox));
+					if (NewSection.NumTriangles > 0 && NewSection.BoneMap.Num() + TriangleBones.Num() > MaxBonesPerSection)
+					{
+						// This section is full, continue on the next one.
+						break;
+					}
 
-#if WITH_EDITORONLY_DATA
-	FSkeletalMeshLODModel* SkeletalMeshLODModel = new FSkeletalMeshLODModel();
-	SkeletalMesh->GetImportedModel()->LODModels.Add(SkeletalMeshLODModel);
+					for (const FBoneIndexType Bone : TriangleBones)
+					{
+						BoneSection[Bone] = NewSectionIndex;
+						NewSection.BoneMap.Add(Bone);
+					}
 
-	SkeletalMeshLODModel->NumVertices = Vertices.Num();
-	SkeletalMeshLODModel->NumTexCoords = UVCount;
+					for (int32 Corner = 0; Corner < 3; Corner += 1)
+					{
+						const uint32 OldVertexIndex = Triangle[Corner];
+						if (VertexRemap[OldVertexIndex] == INDEX_NONE)
+						{
+							VertexRemap[OldVertexIndex] = NewStaticVertices.Add(LODData.StaticVertices[OldVertexIndex]);
+							NewWeights.Add(LODData.Weights[OldVertexIndex]);
+							// Before the split and the weld, each section covers its whole surface.
+							NewSourceVertices.Add(LODData.SourceVertices.Num() > 0
+								? LODData.SourceVertices[OldVertexIndex]
+								: OldVertexIndex - Section.BaseVertexIndex);
+							SectionOldVertices.Add(OldVertexIndex);
+						}
+						NewIndices.Add(VertexRemap[OldVertexIndex]);
+					}
+					NewSection.NumTriangles += 1;
+				}
 
-	SkeletalMeshLODModel->Sections.SetNum(Surfaces.Num());
-	SkeletalMeshLODModel->MaxImportVertex = Vertices.Num() - 1;
+				NewSection.NumVertices = NewStaticVertices.Num() - NewSection.BaseVertexIndex;
+				NewSection.BoneMap.Sort();
 
-	ImportedModelData.NumTexCoords = UVCount;
-	ImportedModelData.MaxMaterialIndex = Surfaces.Num() - 1;
-	ImportedModelData.bHasVertexColors = Surfaces[0].Colors.Num() > 0;;
-	ImportedModelData.bHasNormals = true;
-	ImportedModelData.bHasTangents = true;
-	ImportedModelData.bUseT0AsRefPose = false;
-	ImportedModelData.bDiffPose = false;
-#endif
+				// Reset the remap, so the next section duplicates the shared vertices.
+				for (const uint32 OldVertexIndex : SectionOldVertices)
+				{
+					VertexRemap[OldVertexIndex] = INDEX_NONE;
+				}
+				SectionOldVertices.Reset();
+			}
+		}
 
-	LODMeshRenderData->RenderSections.SetNum(Surfaces.Num());
+		LODData.StaticVertices = MoveTemp(NewStaticVertices);
+		LODData.Weights = MoveTemp(NewWeights);
+		LODData.SourceVertices = MoveTemp(NewSourceVertices);
+		LODData.Indices = MoveTemp(NewIndices);
+		LODData.Sections = MoveTemp(NewSections);
+	}
 
-	for (int32 I = 0; I < Surfaces.Num(); I++)
+	/// Sets the `MaxBoneInfluences` of each section to the influence slots its
+	/// vertices actually use, and the LOD one to the biggest of them: a few
+	/// vertices with many influences no longer make the whole mesh pay for them.
+	void ComputeSectionsMaxBoneInfluences(FRuntimeSkeletalMeshLODData& LODData)
 	{
-		const FMeshSurface& Surface = Surfaces[I];
-		FSkelMeshRenderSection& RenderSection = LODMeshRenderData->RenderSections[I];
+		ParallelFor(LODData.Sections.Num(), [&](const int32 SectionIndex)
+		{
+			FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			int32 MaxBoneInfluences = 1;
+			for (uint32 VertexIndex = Section.BaseVertexIndex; VertexIndex < Section.BaseVertexIndex + Section.NumVertices; VertexIndex += 1)
+			{
+				const FSkinWeightInfo& Weight = LODData.Weights[VertexIndex];
+				for (int32 I = LODData.MaxBoneInfluences - 1; I >= MaxBoneInfluences; I -= 1)
+				{
+					if (Weight.InfluenceWeights[I] > 0)
+					{
+						MaxBoneInfluences = I + 1;
+						break;
+					}
+				}
+			}
+			Section.MaxBoneInfluences = MaxBoneInfluences;
+		});
 
-		RenderSection.bDisabled = false;
-		RenderSection.BaseVertexIndex = SurfaceVertexOffsets[I];
-		RenderSection.NumVertices = Surface.Vertices.Num();
-		RenderSection.BaseIndex = SurfaceIndexOffsets[I];
-		RenderSection.NumTriangles = Surface.Indices.Num() / 3;
-		RenderSection.MaterialIndex = Surfaces[I].MaterialIndex;
-		RenderSection.bCastShadow = true;
-		RenderSection.bRecomputeTangent = false;
-		RenderSection.MaxBoneInfluences = MaxBoneInfluences;
+		LODData.MaxBoneInfluences = 1;
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			LODData.MaxBoneInfluences = FMath::Max(LODData.MaxBoneInfluences, Section.MaxBoneInfluences);
+		}
+	}
 
-#if WITH_EDITOR
-		FSkelMeshSection& MeshSection = SkeletalMeshLODModel->Sections[I];
-		MeshSection.bDisabled = RenderSection.bDisabled;
-		MeshSection.bRecomputeTangent = RenderSection.bRecomputeTangent;
-		MeshSection.bCastShadow = RenderSection.bCastShadow;
-		MeshSection.BaseVertexIndex = RenderSection.BaseVertexIndex;
-		MeshSection.BaseIndex = RenderSection.BaseIndex;
-		MeshSection.MaterialIndex = RenderSection.MaterialIndex;
-		MeshSection.NumVertices = RenderSection.NumVertices;
-		MeshSection.NumTriangles = RenderSection.NumTriangles;
-		MeshSection.MaxBoneInfluences = RenderSection.MaxBoneInfluences;
-		MeshSection.bUse16BitBoneIndex = bUse16BitBoneIndex;
-		MeshSection.OriginalDataSectionIndex = I; // Section IDX for below lookup in user sections data
+	/// Builds the `BoneMap` of each section, so it contains only the bones its
+	/// vertices reference, and remaps the skin weights to the section bones.
+	void BuildSectionsBoneMap(FRuntimeSkeletalMeshLODData& LODData, const int32 BoneNum, const int32 MaxBonesPerSection)
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(BoneMap);
+
+		// Maps the skeleton bone to the section bone.
+		TArray<int32> BoneToSectionBone;
+		BoneToSectionBone.Init(INDEX_NONE, BoneNum);
 
-		MeshSection.SoftVertices.SetNum(Surface.Vertices.Num());
-		for (int32 v = 0; v < Surface.Vertices.Num(); v += 1)
+		bool bNeedSplit = false;
+		for (FRuntimeSkeletalMeshSection& Section : LODData.Sections)
 		{
-			MeshSection.SoftVertices[v].Position = FVector3f(Surface.Vertices[v]);
-			MeshSection.SoftVertices[v].TangentX = FVector3f(Surface.Tangents[v]);
-			MeshSection.SoftVertices[v].TangentY = FVector3f(FVector::CrossProduct(Surface.Normals[v], Surface.Tangents[v]) * (Surface.FlipBinormalSigns[v] ? -1.0 : 1.0));
-			MeshSection.SoftVertices[v].TangentZ = FVector3f(Surface.Normals[v]);
-			for (int32 UVIndex = 0; UVIndex < UVCount; ++UVIndex)
+			Section.BoneMap.Reset();
+			for (uint32 VertexIndex = Section.BaseVertexIndex; VertexIndex < Section.BaseVertexIndex + Section.NumVertices; VertexIndex += 1)
 			{
-				MeshSection.SoftVertices[v].UVs[UVIndex] = FVector2f(Surface.Uvs[v][UVIndex]);
+				const FSkinWeightInfo& Weight = LODData.Weights[VertexIndex];
+				for (int32 I = 0; I < LODData.MaxBoneInfluences; I += 1)
+				{
+					if (Weight.InfluenceWeights[I] > 0 && BoneToSectionBone[Weight.InfluenceBones[I]] == INDEX_NONE)
+					{
+						BoneToSectionBone[Weight.InfluenceBones[I]] = Section.BoneMap.Add(Weight.InfluenceBones[I]);
+					}
+				}
 			}
-			if (Surface.Colors.Num() > v)
+
+			for (const FBoneIndexType Bone : Section.BoneMap)
 			{
-				MeshSection.SoftVertices[v].Color = Surface.Colors[v];
+				BoneToSectionBone[Bone] = INDEX_NONE;
 			}
+			Section.BoneMap.Sort();
+			bNeedSplit |= Section.BoneMap.Num() > MaxBonesPerSection;
+		}
+
+		if (bNeedSplit)
+		{
+			SplitSectionsByBoneLimit(LODData, BoneNum, MaxBonesPerSection);
+		}
 
-			const TArray<FRawBoneInfluence>& VertInfluences = Surface.BoneInfluences[v];
-			
-			FMemory::Memset(MeshSection.SoftVertices[v].InfluenceWeights, 0, sizeof(MeshSection.SoftVertices[v].InfluenceWeights));
-			FMemory::Memset(MeshSection.SoftVertices[v].InfluenceBones, 0, sizeof(MeshSection.SoftVertices[v].InfluenceBones));
+		int32 MaxSectionBones = 0;
+		for (FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			if (Section.BoneMap.Num() == 0)
+			{
+				// This section is not skinned, still it needs a bone to be rendered.
+				Section.BoneMap.Add(0);
+			}
+			MaxSectionBones = FMath::Max(MaxSectionBones, Section.BoneMap.Num());
 
-			int MaxVertInfluencesNum = FMath::Min(VertInfluences.Num(), MAX_TOTAL_INFLUENCES);
-			for (int InfluenceIndex = 0; InfluenceIndex < MaxVertInfluencesNum; InfluenceIndex += 1)
+			for (int32 I = 0; I < Section.BoneMap.Num(); I += 1)
 			{
-				const FRawBoneInfluence& VertInfluence = VertInfluences[InfluenceIndex];
-				// Make sure these are the same.
-				check(v == VertInfluence.VertexIndex);
+				BoneToSectionBone[Section.BoneMap[I]] = I;
+			}
 
-				// Convert 0.0 - 1.0 range to 0 - 65535
-				const uint16 EncodedWeight = FMath::Clamp(VertInfluence.Weight, 0., 1.) * 65535.;
+			for (uint32 VertexIndex = Section.BaseVertexIndex; VertexIndex < Section.BaseVertexIndex + Section.NumVertices; VertexIndex += 1)
+			{
+				FSkinWeightInfo& Weight = LODData.Weights[VertexIndex];
+				for (int32 I = 0; I < MAX_TOTAL_INFLUENCES; I += 1)
+				{
+					Weight.InfluenceBones[I] = Weight.InfluenceWeights[I] > 0 ? BoneToSectionBone[Weight.InfluenceBones[I]] : 0;
+				}
+			}
 
-				MeshSection.SoftVertices[v].InfluenceWeights[InfluenceIndex] = EncodedWeight;
-				MeshSection.SoftVertices[v].InfluenceBones[InfluenceIndex] = EncodedWeight == 0 ? 0 : VertInfluence.BoneIndex;
+			for (const FBoneIndexType Bone : Section.BoneMap)
+			{
+				BoneToSectionBone[Bone] = INDEX_NONE;
 			}
 		}
 
-		{
-			// In Editor, we want to make sure the data is in sync between
-			// `UserSectionsData` and RenderSections.
-			FSkelMeshSourceSectionUserData& UserSectionData = SkeletalMeshLODModel->UserSectionsData.FindOrAdd(I);
-			UserSectionData.bDisabled = MeshSection.bDisabled;
-			UserSectionData.bCastShadow = MeshSection.bCastShadow;
-			UserSectionData.bRecomputeTangent = MeshSection.bRecomputeTangent;
-			UserSectionData.RecomputeTangentsVertexMaskChannel = MeshSection.RecomputeTangentsVertexMaskChannel;
-			UserSectionData.GenerateUpToLodIndex = MeshSection.GenerateUpToLodIndex;
+		// The skin weights store the section bone index, so 8 bits are enough
+		// unless a section uses more than 256 bones.
+		LODData.bUse16BitBoneIndex = MaxSectionBones > MAX_uint8 + 1;
+	}
 
-			const bool IsRenderDataInSync =
-				UserSectionData.bDisabled == RenderSection.bDisabled &&
-				UserSectionData.bCastShadow == RenderSection.bCastShadow &&
-				UserSectionData.bRecomputeTangent == RenderSection.bRecomputeTangent &&
-				UserSectionData.RecomputeTangentsVertexMaskChannel == RenderSection.RecomputeTangentsVertexMaskChannel &&
-				UserSectionData.CorrespondClothAssetIndex == RenderSection.CorrespondClothAssetIndex &&
-				UserSectionData.ClothingData.AssetGuid == RenderSection.ClothingData.AssetGuid &&
-				UserSectionData.ClothingData.AssetLodIndex == RenderSection.ClothingData.AssetLodIndex;
+	/// Merges the sections that share a material in a single section, as long
+	/// as the merged section doesn't exceed `MaxBonesPerSection` bones. The
+	/// sections are moved so the ones with the same material are contiguous:
+	/// each surface keeps a contiguous range, and `SurfaceOrder` records the
+	/// new order of the surfaces.
+	void MergeSectionsByMaterial(FRuntimeSkeletalMeshLODData& LODData, const int32 BoneNum, const int32 MaxBonesPerSection)
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(Merge);
 
-			check(IsRenderDataInSync); // this must always be true or unreal will choke.
+		// The materials, in the order they first appear.
+		TMap<int32, int32> MaterialsOrder;
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			if (!MaterialsOrder.Contains(Section.MaterialIndex))
+			{
+				MaterialsOrder.Add(Section.MaterialIndex, MaterialsOrder.Num());
+			}
 		}
-#endif
 
-		// This is used when you have no overlapping Vertices.
+		TArray<int32> SectionsOrder;
+		SectionsOrder.SetNumUninitialized(LODData.Sections.Num());
+		for (int32 SectionIndex = 0; SectionIndex < LODData.Sections.Num(); SectionIndex += 1)
 		{
-			RenderSection.DuplicatedVerticesBuffer.DupVertData.ResizeBuffer(1);
-			uint8* VertData = RenderSection.DuplicatedVerticesBuffer.DupVertData.GetDataPointer();
-			FMemory::Memzero(VertData, sizeof(uint32) * RenderSection.DuplicatedVerticesBuffer.DupVertData.Num());
-
-			RenderSection.DuplicatedVerticesBuffer.DupVertIndexData.ResizeBuffer(RenderSection.NumVertices);
-			uint8* IndexData = RenderSection.DuplicatedVerticesBuffer.DupVertIndexData.GetDataPointer();
-			FMemory::Memzero(IndexData, RenderSection.NumVertices * sizeof(FIndexLengthPair));
+			SectionsOrder[SectionIndex] = SectionIndex;
 		}
-	}
-
-	// Set the Indices.
-	{
-#if WITH_EDITOR
-		SkeletalMeshLODModel->IndexBuffer = Indices;
-#endif
+		Algo::StableSort(SectionsOrder, [&](const int32 A, const int32 B)
+		{
+			return MaterialsOrder[LODData.Sections[A].MaterialIndex] < MaterialsOrder[LODData.Sections[B].MaterialIndex];
+		});
+
+		// Contains, for each bone, its index in the `BoneMap` of the section
+		// being merged.
+		TArray<int32> BoneToMergedBone;
+		BoneToMergedBone.Init(INDEX_NONE, BoneNum);
+
+		TArray<FRuntimeSkeletalMeshSection> MergedSections;
+		// The merged section each source section goes to.
+		TArray<int32> SectionsMergedSection;
+		SectionsMergedSection.SetNumUninitialized(LODData.Sections.Num());
+		for (const int32 SectionIndex : SectionsOrder)
+		{
+			const FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
 
-		LODMeshRenderData->MultiSizeIndexContainer.RebuildIndexBuffer(
-			// Dynamically chose the index buffer size.
-			Indices.Num() < MAX_uint16 ? sizeof(uint16) : sizeof(uint32),
-			Indices);
+			bool bCanMerge = MergedSections.Num() > 0 && MergedSections.Last().MaterialIndex == Section.MaterialIndex;
+			if (bCanMerge)
+			{
+				int32 NewBones = 0;
+				for (const FBoneIndexType Bone : Section.BoneMap)
+				{
+					NewBones += BoneToMergedBone[Bone] == INDEX_NONE ? 1 : 0;
+				}
+				bCanMerge = MergedSections.Last().BoneMap.Num() + NewBones <= MaxBonesPerSection;
+			}
 
-		// Test our data is good and the renderer can access it.
+			if (!bCanMerge)
+			{
+				if (MergedSections.Num() > 0)
+				{
+					for (const FBoneIndexType Bone : MergedSections.Last().BoneMap)
+					{
+						BoneToMergedBone[Bone] = INDEX_NONE;
+					}
+				}
+
+				FRuntimeSkeletalMeshSection& MergedSection = MergedSections.AddDefaulted_GetRef();
+				MergedSection.SurfaceIndex = Section.SurfaceIndex;
+				MergedSection.MaterialIndex = Section.MaterialIndex;
+			}
+
+			FRuntimeSkeletalMeshSection& MergedSection = MergedSections.Last();
+			MergedSection.NumVertices += Section.NumVertices;
+			MergedSection.NumTriangles += Section.NumTriangles;
+			MergedSection.MaxBoneInfluences = FMath::Max(MergedSection.MaxBoneInfluences, Section.MaxBoneInfluences);
+			for (const FBoneIndexType Bone : Section.BoneMap)
+			{
+				if (BoneToMergedBone[Bone] == INDEX_NONE)
+				{
+					BoneToMergedBone[Bone] = MergedSection.BoneMap.Add(Bone);
+				}
+			}
+			SectionsMergedSection[SectionIndex] = MergedSections.Num() - 1;
+		}
+
+		if (MergedSections.Num() == LODData.Sections.Num())
+		{
+			// Nothing to merge, keep the sections where they are.
+			return;
+		}
+
+		// Assign the new ranges, in the new order.
+		TArray<uint32> SectionsBaseVertexIndex;
+		TArray<uint32> SectionsBaseIndex;
+		SectionsBaseVertexIndex.SetNumUninitialized(LODData.Sections.Num());
+		SectionsBaseIndex.SetNumUninitialized(LODData.Sections.Num());
+		uint32 VerticesNum = 0;
+		uint32 IndicesNum = 0;
+		int32 LastMergedSection = INDEX_NONE;
+		int32 LastSurfaceIndex = INDEX_NONE;
+		LODData.SurfaceOrder.Reset();
+		for (const int32 SectionIndex : SectionsOrder)
+		{
+			const FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			SectionsBaseVertexIndex[SectionIndex] = VerticesNum;
+			SectionsBaseIndex[SectionIndex] = IndicesNum;
+
+			if (SectionsMergedSection[SectionIndex] != LastMergedSection)
+			{
+				LastMergedSection = SectionsMergedSection[SectionIndex];
+				MergedSections[LastMergedSection].BaseVertexIndex = VerticesNum;
+				MergedSections[LastMergedSection].BaseIndex = IndicesNum;
+			}
+
+			// The sections of a surface are contiguous, the first one starts the surface.
+			if (Section.SurfaceIndex != LastSurfaceIndex)
+			{
+				LODData.SurfaceVertexOffsets[Section.SurfaceIndex] = VerticesNum;
+				LODData.SurfaceIndexOffsets[Section.SurfaceIndex] = IndicesNum;
+				LODData.SurfaceOrder.Add(Section.SurfaceIndex);
+				LastSurfaceIndex = Section.SurfaceIndex;
+			}
+
+			VerticesNum += Section.NumVertices;
+			IndicesNum += Section.NumTriangles * 3;
+		}
+
+		TArray<FStaticMeshBuildVertex> NewStaticVertices;
+		TArray<FSkinWeightInfo> NewWeights;
+		TArray<uint32> NewSourceVertices;
+		TArray<uint32> NewIndices;
+		NewStaticVertices.SetNumUninitialized(VerticesNum);
+		NewWeights.SetNumUninitialized(VerticesNum);
+		NewIndices.SetNumUninitialized(IndicesNum);
+		if (LODData.SourceVertices.Num() > 0)
+		{
+			NewSourceVertices.SetNumUninitialized(VerticesNum);
+		}
+
+		ParallelFor(LODData.Sections.Num(), [&](const int32 SectionIndex)
+		{
+			const FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			const FRuntimeSkeletalMeshSection& MergedSection = MergedSections[SectionsMergedSection[SectionIndex]];
+			const uint32 NewBaseVertexIndex = SectionsBaseVertexIndex[SectionIndex];
+
+			FMemory::Memcpy(
+				NewStaticVertices.GetData() + NewBaseVertexIndex,
+				LODData.StaticVertices.GetData() + Section.BaseVertexIndex,
+				Section.NumVertices * sizeof(FStaticMeshBuildVertex));
+			if (NewSourceVertices.Num() > 0)
+			{
+				FMemory::Memcpy(
+					NewSourceVertices.GetData() + NewBaseVertexIndex,
+					LODData.SourceVertices.GetData() + Section.BaseVertexIndex,
+					Section.NumVertices * sizeof(uint32));
+			}
+
+			// The skin weights store the section bone index, remap it to the
+			// merged section one.
+			TArray<int32, TInlineAllocator<256>> SectionBoneToMergedBone;
+			SectionBoneToMergedBone.SetNumUninitialized(Section.BoneMap.Num());
+			for (int32 I = 0; I < Section.BoneMap.Num(); I += 1)
+			{
+				SectionBoneToMergedBone[I] = MergedSection.BoneMap.Find(Section.BoneMap[I]);
+			}
+			for (uint32 I = 0; I < Section.NumVertices; I += 1)
+			{
+				FSkinWeightInfo& Weight = NewWeights[NewBaseVertexIndex + I];
+				Weight = LODData.Weights[Section.BaseVertexIndex + I];
+				for (int32 InfluenceIndex = 0; InfluenceIndex < MAX_TOTAL_INFLUENCES; InfluenceIndex += 1)
+				{
+					Weight.InfluenceBones[InfluenceIndex] = Weight.InfluenceWeights[InfluenceIndex] > 0
+						? SectionBoneToMergedBone[Weight.InfluenceBones[InfluenceIndex]]
+						: 0;
+				}
+			}
+
+			const uint32 NewBaseIndex = SectionsBaseIndex[SectionIndex];
+			for (uint32 I = 0; I < Section.NumTriangles * 3; I += 1)
+			{
+				NewIndices[NewBaseIndex + I] = LODData.Indices[Section.BaseIndex + I] - Section.BaseVertexIndex + NewBaseVertexIndex;
+			}
+		});
+
+		int32 MaxSectionBones = 0;
+		for (const FRuntimeSkeletalMeshSection& MergedSection : MergedSections)
+		{
+			MaxSectionBones = FMath::Max(MaxSectionBones, MergedSection.BoneMap.Num());
+		}
+
+		LODData.StaticVertices = MoveTemp(NewStaticVertices);
+		LODData.Weights = MoveTemp(NewWeights);
+		LODData.SourceVertices = MoveTemp(NewSourceVertices);
+		LODData.Indices = MoveTemp(NewIndices);
+		LODData.Sections = MoveTemp(MergedSections);
+		LODData.bUse16BitBoneIndex = MaxSectionBones > MAX_uint8 + 1;
+		LODData.bMergedSections = true;
+	}
+
+	/// A spatial hash of the vertex positions of a section: with cells at least
+	/// as big as the search distance, the near vertices are all in the 27 cells
+	/// around a position.
+	struct FVertexSpatialHash
+	{
+		float CellSize;
+		/// The last vertex added to each cell.
+		TMap<FIntVector, int32> CellsLastVertex;
+		/// The previous vertex of the same cell, by section vertex.
+		TArray<int32> PreviousVertex;
+
+		explicit FVertexSpatialHash(const float Distance, const int32 VerticesNum)
+			: CellSize(FMath::Max(Distance, UE_KINDA_SMALL_NUMBER))
+		{
+			CellsLastVertex.Reserve(VerticesNum);
+			PreviousVertex.Init(INDEX_NONE, VerticesNum);
+		}
+
+		FIntVector GetCell(const FVector3f& Position) const
+		{
+			return FIntVector(
+				FMath::FloorToInt32(Position.X / CellSize),
+				FMath::FloorToInt32(Position.Y / CellSize),
+				FMath::FloorToInt32(Position.Z / CellSize));
+		}
+
+		void Add(const int32 Vertex, const FVector3f& Position)
+		{
+			int32& LastVertex = CellsLastVertex.FindOrAdd(GetCell(Position), INDEX_NONE);
+			PreviousVertex[Vertex] = LastVertex;
+			LastVertex = Vertex;
+		}
+
+		/// Calls `Visit` with the vertices in the cells around `Position`, until
+		/// it returns false.
+		template<typename FVisit>
+		void ForEachNear(const FVector3f& Position, FVisit&& Visit) const
+		{
+			const FIntVector Cell = GetCell(Position);
+			for (int32 Z = -1; Z <= 1; Z += 1)
+			{
+				for (int32 Y = -1; Y <= 1; Y += 1)
+				{
+					for (int32 X = -1; X <= 1; X += 1)
+					{
+						const int32* LastVertex = CellsLastVertex.Find(Cell + FIntVector(X, Y, Z));
+						for (int32 Vertex = LastVertex ? *LastVertex : INDEX_NONE; Vertex != INDEX_NONE; Vertex = PreviousVertex[Vertex])
+						{
+							if (!Visit(Vertex))
+							{
+								return;
+							}
+						}
+					}
+				}
+			}
+		}
+	};
+
+	/// Returns true when the two vertices are equal, within the weld tolerances.
+	bool CanWeldVertices(
+		const FRuntimeSkeletalMeshLODData& LODData,
+		const uint32 A,
+		const uint32 B,
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+	{
+		const FStaticMeshBuildVertex& VertexA = LODData.StaticVertices[A];
+		const FStaticMeshBuildVertex& VertexB = LODData.StaticVertices[B];
+
+		if (FVector3f::DistSquared(VertexA.Position, VertexB.Position) > FMath::Square(BuildOptions.WeldPositionTolerance)
+			|| FVector3f::DistSquared(VertexA.TangentZ, VertexB.TangentZ) > FMath::Square(BuildOptions.WeldNormalTolerance)
+			|| FVector3f::DistSquared(VertexA.TangentX, VertexB.TangentX) > FMath::Square(BuildOptions.WeldNormalTolerance)
+			|| FVector3f::DotProduct(VertexA.TangentY, VertexB.TangentY) <= 0.0f
+			|| VertexA.Color != VertexB.Color)
+		{
+			return false;
+		}
+
+		for (int32 UVIndex = 0; UVIndex < LODData.UVCount; UVIndex += 1)
+		{
+			if (!VertexA.UVs[UVIndex].Equals(VertexB.UVs[UVIndex], BuildOptions.WeldUVTolerance))
+			{
+				return false;
+			}
+		}
+
+		const FSkinWeightInfo& WeightA = LODData.Weights[A];
+		const FSkinWeightInfo& WeightB = LODData.Weights[B];
+		const int32 WeightTolerance = FMath::RoundToInt32(BuildOptions.WeldWeightTolerance * 65535.0f);
+		for (int32 I = 0; I < LODData.MaxBoneInfluences; I += 1)
+		{
+			if (WeightA.InfluenceBones[I] != WeightB.InfluenceBones[I]
+				|| FMath::Abs(int32(WeightA.InfluenceWeights[I]) - int32(WeightB.InfluenceWeights[I])) > WeightTolerance)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// Merges the vertices of each section that are equal within the weld
+	/// tolerances, then compacts the vertex buffers.
+	void WeldSectionsVertices(FRuntimeSkeletalMeshLODData& LODData, const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(Weld);
+
+		// For each vertex, the section relative index of the vertex it's welded to.
+		TArray<uint32> VertexRemap;
+		VertexRemap.SetNumUninitialized(LODData.StaticVertices.Num());
+		TArray<uint32> SectionsVerticesNum;
+		SectionsVerticesNum.SetNumZeroed(LODData.Sections.Num());
+
+		ParallelFor(LODData.Sections.Num(), [&](const int32 SectionIndex)
+		{
+			const FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			FVertexSpatialHash SpatialHash(BuildOptions.WeldPositionTolerance, Section.NumVertices);
+
+			uint32 KeptVertices = 0;
+			for (uint32 VertexIndex = Section.BaseVertexIndex; VertexIndex < Section.BaseVertexIndex + Section.NumVertices; VertexIndex += 1)
+			{
+				const FVector3f& Position = LODData.StaticVertices[VertexIndex].Position;
+				int32 WeldTo = INDEX_NONE;
+				SpatialHash.ForEachNear(Position, [&](const int32 KeptVertex)
+				{
+					if (CanWeldVertices(LODData, Section.BaseVertexIndex + KeptVertex, VertexIndex, BuildOptions))
+					{
+						WeldTo = Section.BaseVertexIndex + KeptVertex;
+						return false;
+					}
+					return true;
+				});
+
+				if (WeldTo != INDEX_NONE)
+				{
+					VertexRemap[VertexIndex] = VertexRemap[WeldTo];
+				}
+				else
+				{
+					VertexRemap[VertexIndex] = KeptVertices;
+					KeptVertices += 1;
+					SpatialHash.Add(VertexIndex - Section.BaseVertexIndex, Position);
+				}
+			}
+			SectionsVerticesNum[SectionIndex] = KeptVertices;
+		});
+
+		uint32 VerticesNum = 0;
+		TArray<uint32> SectionsBaseVertexIndex;
+		SectionsBaseVertexIndex.SetNumUninitialized(LODData.Sections.Num());
+		for (int32 SectionIndex = 0; SectionIndex < LODData.Sections.Num(); SectionIndex += 1)
+		{
+			SectionsBaseVertexIndex[SectionIndex] = VerticesNum;
+			VerticesNum += SectionsVerticesNum[SectionIndex];
+		}
+
+		if (VerticesNum == uint32(LODData.StaticVertices.Num()))
+		{
+			// Nothing to weld.
+			return;
+		}
+
+		TArray<FStaticMeshBuildVertex> NewStaticVertices;
+		TArray<FSkinWeightInfo> NewWeights;
+		TArray<uint32> NewSourceVertices;
+		NewStaticVertices.SetNumUninitialized(VerticesNum);
+		NewWeights.SetNumUninitialized(VerticesNum);
+		NewSourceVertices.SetNumUninitialized(VerticesNum);
+
+		ParallelFor(LODData.Sections.Num(), [&](const int32 SectionIndex)
+		{
+			FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			const uint32 NewBaseVertexIndex = SectionsBaseVertexIndex[SectionIndex];
+
+			// The kept vertices are numbered in order, so a vertex is kept when
+			// its index is the next one.
+			uint32 NextVertex = 0;
+			for (uint32 I = 0; I < Section.NumVertices; I += 1)
+			{
+				const uint32 VertexIndex = Section.BaseVertexIndex + I;
+				if (VertexRemap[VertexIndex] == NextVertex)
+				{
+					NewStaticVertices[NewBaseVertexIndex + NextVertex] = LODData.StaticVertices[VertexIndex];
+					NewWeights[NewBaseVertexIndex + NextVertex] = LODData.Weights[VertexIndex];
+					NewSourceVertices[NewBaseVertexIndex + NextVertex] = LODData.SourceVertices.Num() > 0 ? LODData.SourceVertices[VertexIndex] : I;
+					NextVertex += 1;
+				}
+			}
+
+			for (uint32 I = Section.BaseIndex; I < Section.BaseIndex + Section.NumTriangles * 3; I += 1)
+			{
+				LODData.Indices[I] = VertexRemap[LODData.Indices[I]] + NewBaseVertexIndex;
+			}
+
+			Section.BaseVertexIndex = NewBaseVertexIndex;
+			Section.NumVertices = SectionsVerticesNum[SectionIndex];
+		});
+
+		// The sections of a surface are contiguous, the first one starts the surface.
+		int32 LastSurfaceIndex = INDEX_NONE;
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			if (Section.SurfaceIndex != LastSurfaceIndex)
+			{
+				LODData.SurfaceVertexOffsets[Section.SurfaceIndex] = Section.BaseVertexIndex;
+				LastSurfaceIndex = Section.SurfaceIndex;
+			}
+		}
+
+		LODData.StaticVertices = MoveTemp(NewStaticVertices);
+		LODData.Weights = MoveTemp(NewWeights);
+		LODData.SourceVertices = MoveTemp(NewSourceVertices);
+	}
+
+	/// Builds, for each vertex, the list of the other vertices of its section at
+	/// the same position: the recompute tangents skinning uses it to keep the
+	/// normals smooth across the seams, where the vertices stay split.
+	/// The vertices are grouped in clusters, each one within `PositionTolerance`
+	/// from its first vertex. Each cluster is stored twice in a row, so the other
+	/// vertices of its `N`th vertex are the `Size - 1` that follow it: the tables
+	/// grow linearly with the vertices at the same position.
+	void BuildSectionsDuplicatedVertices(FRuntimeSkeletalMeshLODData& LODData, const float PositionTolerance)
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(DuplicatedVertices);
+
+		ParallelFor(LODData.Sections.Num(), [&](const int32 SectionIndex)
+		{
+			FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			const FStaticMeshBuildVertex* Vertices = LODData.StaticVertices.GetData() + Section.BaseVertexIndex;
+
+			// Only the first vertex of each cluster is in the hash, so a vertex is
+			// compared with the near clusters, not with all their vertices.
+			FVertexSpatialHash SpatialHash(PositionTolerance, Section.NumVertices);
+			TArray<uint32> ClustersFirstVertex;
+			TArray<uint32> ClustersSize;
+			TArray<uint32> VerticesCluster;
+			VerticesCluster.SetNumUninitialized(Section.NumVertices);
+			for (uint32 I = 0; I < Section.NumVertices; I += 1)
+			{
+				int32 Cluster = INDEX_NONE;
+				SpatialHash.ForEachNear(Vertices[I].Position, [&](const int32 Other)
+				{
+					if (FVector3f::DistSquared(Vertices[I].Position, Vertices[ClustersFirstVertex[Other]].Position) <= FMath::Square(PositionTolerance))
+					{
+						Cluster = Other;
+						return false;
+					}
+					return true;
+				});
+
+				if (Cluster == INDEX_NONE)
+				{
+					Cluster = ClustersFirstVertex.Add(I);
+					ClustersSize.Add(0);
+					SpatialHash.Add(Cluster, Vertices[I].Position);
+				}
+				VerticesCluster[I] = Cluster;
+				ClustersSize[Cluster] += 1;
+			}
+
+			Section.DuplicatedVertices.Reset();
+			Section.DuplicatedVerticesIndex.Reset();
+			if (ClustersFirstVertex.Num() == int32(Section.NumVertices))
+			{
+				// No seams.
+				return;
+			}
+
+			// Sort the vertices by cluster: only the clusters with more than one
+			// vertex are stored.
+			TArray<uint32> ClustersOffset;
+			ClustersOffset.SetNumUninitialized(ClustersSize.Num());
+			uint32 DuplicatedVerticesNum = 0;
+			for (int32 Cluster = 0; Cluster < ClustersSize.Num(); Cluster += 1)
+			{
+				ClustersOffset[Cluster] = DuplicatedVerticesNum;
+				DuplicatedVerticesNum += ClustersSize[Cluster] > 1 ? ClustersSize[Cluster] * 2 : 0;
+			}
+
+			TArray<uint32> ClustersFilled;
+			ClustersFilled.SetNumZeroed(ClustersSize.Num());
+			Section.DuplicatedVertices.SetNumUninitialized(DuplicatedVerticesNum);
+			Section.DuplicatedVerticesIndex.SetNumZeroed(Section.NumVertices);
+			for (uint32 I = 0; I < Section.NumVertices; I += 1)
+			{
+				const uint32 Cluster = VerticesCluster[I];
+				const uint32 ClusterSize = ClustersSize[Cluster];
+				if (ClusterSize < 2)
+				{
+					continue;
+				}
+
+				const uint32 Position = ClustersFilled[Cluster];
+				ClustersFilled[Cluster] += 1;
+				Section.DuplicatedVertices[ClustersOffset[Cluster] + Position] = I;
+				Section.DuplicatedVertices[ClustersOffset[Cluster] + ClusterSize + Position] = I;
+
+				FIndexLengthPair& IndexLength = Section.DuplicatedVerticesIndex[I];
+				IndexLength.Index = ClustersOffset[Cluster] + Position + 1;
+				IndexLength.Length = ClusterSize - 1;
+			}
+		});
+	}
+
+	/// The size of the post transform vertex cache the triangles are sorted for.
+	constexpr int32 VertexCacheSize = 32;
+
+	/// The score of a vertex, as described by Tom Forsyth in "Linear-Speed
+	/// Vertex Cache Optimisation": the triangles using the vertices with the
+	/// highest score are emitted first.
+	float ComputeVertexCacheScore(const int32 CachePosition, const int32 RemainingTriangles)
+	{
+		if (RemainingTriangles == 0)
+		{
+			// No triangle needs this vertex anymore.
+			return -1.0f;
+		}
+
+		float Score = 0.0f;
+		if (CachePosition >= 0)
+		{
+			if (CachePosition < 3)
+			{
+				// This vertex was used by the last triangle: a fixed score, so the
+				// triangles sharing only one vertex with it are not preferred.
+				Score = 0.75f;
+			}
+			else
+			{
+				Score = FMath::Pow(1.0f - float(CachePosition - 3) / float(VertexCacheSize - 3), 1.5f);
+			}
+		}
+
+		// Prefer the vertices with few triangles left, so they leave the cache soon.
+		Score += 2.0f * FMath::InvSqrt(float(RemainingTriangles));
+		return Score;
+	}
+
+	/// Reorders the triangles of `Indices`, that index `VerticesNum` vertices,
+	/// to maximize the post transform vertex cache hits.
+	void OptimizeVertexCache(TArrayView<uint32> Indices, const int32 VerticesNum)
+	{
+		const int32 TrianglesNum = Indices.Num() / 3;
+		if (TrianglesNum < 2)
+		{
+			return;
+		}
+
+		// The triangles using each vertex: the first `RemainingTriangles` of
+		// each list are the ones not emitted yet.
+		TArray<int32> VertexTrianglesOffset;
+		VertexTrianglesOffset.SetNumZeroed(VerticesNum + 1);
+		for (const uint32 Index : Indices)
+		{
+			VertexTrianglesOffset[Index + 1] += 1;
+		}
+		for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex += 1)
+		{
+			VertexTrianglesOffset[VertexIndex + 1] += VertexTrianglesOffset[VertexIndex];
+		}
+
+		TArray<int32> VertexTriangles;
+		VertexTriangles.SetNumUninitialized(Indices.Num());
+		TArray<int32> RemainingTriangles;
+		RemainingTriangles.SetNumZeroed(VerticesNum);
+		for (int32 I = 0; I < Indices.Num(); I += 1)
+		{
+			const uint32 VertexIndex = Indices[I];
+			VertexTriangles[VertexTrianglesOffset[VertexIndex] + RemainingTriangles[VertexIndex]] = I / 3;
+			RemainingTriangles[VertexIndex] += 1;
+		}
+
+		TArray<int32> CachePosition;
+		CachePosition.Init(INDEX_NONE, VerticesNum);
+		TArray<float> VertexScore;
+		VertexScore.SetNumUninitialized(VerticesNum);
+		for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex += 1)
+		{
+			VertexScore[VertexIndex] = ComputeVertexCacheScore(INDEX_NONE, RemainingTriangles[VertexIndex]);
+		}
+
+		TArray<float> TriangleScore;
+		TriangleScore.SetNumUninitialized(TrianglesNum);
+		TArray<bool> Emitted;
+		Emitted.Init(false, TrianglesNum);
+		int32 BestTriangle = 0;
+		for (int32 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex += 1)
+		{
+			TriangleScore[TriangleIndex] =
+				VertexScore[Indices[TriangleIndex * 3 + 0]] +
+				VertexScore[Indices[TriangleIndex * 3 + 1]] +
+				VertexScore[Indices[TriangleIndex * 3 + 2]];
+			if (TriangleScore[TriangleIndex] > TriangleScore[BestTriangle])
+			{
+				BestTriangle = TriangleIndex;
+			}
+		}
+
+		TArray<uint32> NewIndices;
+		NewIndices.Reserve(Indices.Num());
+
+		// The cache also holds the vertices pushed out by the last triangle, so
+		// their score is updated.
+		TArray<uint32, TInlineAllocator<VertexCacheSize + 3>> Cache;
+		TArray<uint32, TInlineAllocator<VertexCacheSize + 3>> NewCache;
+		int32 NextTriangle = 0;
+
+		for (int32 EmittedNum = 0; EmittedNum < TrianglesNum; EmittedNum += 1)
+		{
+			if (BestTriangle == INDEX_NONE)
+			{
+				// None of the cached vertices has triangles left, continue with
+				// the first triangle not emitted yet.
+				while (Emitted[NextTriangle])
+				{
+					NextTriangle += 1;
+				}
+				BestTriangle = NextTriangle;
+			}
+
+			const uint32 Triangle[3] = {
+				Indices[BestTriangle * 3 + 0],
+				Indices[BestTriangle * 3 + 1],
+				Indices[BestTriangle * 3 + 2]};
+			Emitted[BestTriangle] = true;
+			NewIndices.Append(Triangle, 3);
+
+			for (const uint32 VertexIndex : Triangle)
+			{
+				int32* Triangles = VertexTriangles.GetData() + VertexTrianglesOffset[VertexIndex];
+				for (int32 I = 0; I < RemainingTriangles[VertexIndex]; I += 1)
+				{
+					if (Triangles[I] == BestTriangle)
+					{
+						Swap(Triangles[I], Triangles[RemainingTriangles[VertexIndex] - 1]);
+						RemainingTriangles[VertexIndex] -= 1;
+						break;
+					}
+				}
+			}
+
+			// The triangle vertices move to the front of the cache.
+			NewCache.Reset();
+			NewCache.Append(Triangle, 3);
+			for (const uint32 VertexIndex : Cache)
+			{
+				if (VertexIndex != Triangle[0] && VertexIndex != Triangle[1] && VertexIndex != Triangle[2])
+				{
+					NewCache.Add(VertexIndex);
+				}
+			}
+
+			for (int32 I = 0; I < NewCache.Num(); I += 1)
+			{
+				const uint32 VertexIndex = NewCache[I];
+				CachePosition[VertexIndex] = I < VertexCacheSize ? I : INDEX_NONE;
+				VertexScore[VertexIndex] = ComputeVertexCacheScore(CachePosition[VertexIndex], RemainingTriangles[VertexIndex]);
+			}
+
+			// Only the triangles using the cached vertices changed score.
+			BestTriangle = INDEX_NONE;
+			float BestScore = -1.0f;
+			for (const uint32 VertexIndex : NewCache)
+			{
+				const int32* Triangles = VertexTriangles.GetData() + VertexTrianglesOffset[VertexIndex];
+				for (int32 I = 0; I < RemainingTriangles[VertexIndex]; I += 1)
+				{
+					const int32 TriangleIndex = Triangles[I];
+					TriangleScore[TriangleIndex] =
+						VertexScore[Indices[TriangleIndex * 3 + 0]] +
+						VertexScore[Indices[TriangleIndex * 3 + 1]] +
+						VertexScore[Indices[TriangleIndex * 3 + 2]];
+					if (TriangleScore[TriangleIndex] > BestScore)
+					{
+						BestScore = TriangleScore[TriangleIndex];
+						BestTriangle = TriangleIndex;
+					}
+				}
+			}
+
+			Cache.Reset();
+			Cache.Append(NewCache.GetData(), FMath::Min(NewCache.Num(), VertexCacheSize));
+		}
+
+		FMemory::Memcpy(Indices.GetData(), NewIndices.GetData(), NewIndices.Num() * sizeof(uint32));
+	}
+
+	/// Reorders the clusters of the already cache optimized `Indices`, so the
+	/// ones facing outward are drawn first and occlude the others: this is a
+	/// simplified version of "Fast Triangle Reordering for Vertex Locality and
+	/// Reduced Overdraw" (Sander, Nehab, Barczak).
+	/// A new cluster starts where the vertex cache is cold, so the sort doesn't
+	/// undo the vertex cache optimization.
+	void OptimizeOverdraw(TArrayView<uint32> Indices, const FStaticMeshBuildVertex* Vertices, const int32 VerticesNum)
+	{
+		const int32 TrianglesNum = Indices.Num() / 3;
+
+		struct FCluster
+		{
+			int32 FirstTriangle = 0;
+			int32 TrianglesNum = 0;
+			float SortKey = 0.0f;
+		};
+		TArray<FCluster> Clusters;
+
+		// Simulate a FIFO cache to find where the triangles stop sharing vertices.
+		TArray<int32> CacheTime;
+		CacheTime.Init(-VertexCacheSize - 1, VerticesNum);
+		int32 Time = 0;
+		for (int32 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex += 1)
+		{
+			int32 Misses = 0;
+			for (int32 Corner = 0; Corner < 3; Corner += 1)
+			{
+				const uint32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+				if (Time - CacheTime[VertexIndex] > VertexCacheSize)
+				{
+					CacheTime[VertexIndex] = Time;
+					Time += 1;
+					Misses += 1;
+				}
+			}
+
+			if (Clusters.Num() == 0 || Misses == 3)
+			{
+				Clusters.Add({TriangleIndex, 0, 0.0f});
+			}
+			Clusters.Last().TrianglesNum += 1;
+		}
+
+		if (Clusters.Num() < 2)
+		{
+			return;
+		}
+
+		// The area weighted centroid and normal of each cluster.
+		TArray<FVector3f> ClustersCentroid;
+		TArray<FVector3f> ClustersNormal;
+		ClustersCentroid.Init(FVector3f::ZeroVector, Clusters.Num());
+		ClustersNormal.Init(FVector3f::ZeroVector, Clusters.Num());
+		FVector3f MeshCentroid = FVector3f::ZeroVector;
+		float MeshArea = 0.0f;
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex += 1)
+		{
+			const FCluster& Cluster = Clusters[ClusterIndex];
+			float ClusterArea = 0.0f;
+			for (int32 TriangleIndex = Cluster.FirstTriangle; TriangleIndex < Cluster.FirstTriangle + Cluster.TrianglesNum; TriangleIndex += 1)
+			{
+				const FVector3f& A = Vertices[Indices[TriangleIndex * 3 + 0]].Position;
+				const FVector3f& B = Vertices[Indices[TriangleIndex * 3 + 1]].Position;
+				const FVector3f& C = Vertices[Indices[TriangleIndex * 3 + 2]].Position;
+				const FVector3f Normal = FVector3f::CrossProduct(B - A, C - A);
+				const float Area = Normal.Size();
+				ClustersCentroid[ClusterIndex] += (A + B + C) * (Area / 3.0f);
+				ClustersNormal[ClusterIndex] += Normal;
+				ClusterArea += Area;
+			}
+			MeshCentroid += ClustersCentroid[ClusterIndex];
+			MeshArea += ClusterArea;
+			if (ClusterArea > UE_SMALL_NUMBER)
+			{
+				ClustersCentroid[ClusterIndex] /= ClusterArea;
+			}
+		}
+		if (MeshArea > UE_SMALL_NUMBER)
+		{
+			MeshCentroid /= MeshArea;
+		}
+
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex += 1)
+		{
+			Clusters[ClusterIndex].SortKey = FVector3f::DotProduct(
+				ClustersCentroid[ClusterIndex] - MeshCentroid,
+				ClustersNormal[ClusterIndex].GetSafeNormal());
+		}
+
+		Clusters.StableSort([](const FCluster& A, const FCluster& B)
+		{
+			return A.SortKey > B.SortKey;
+		});
+
+		TArray<uint32> NewIndices;
+		NewIndices.Reserve(Indices.Num());
+		for (const FCluster& Cluster : Clusters)
+		{
+			NewIndices.Append(Indices.GetData() + Cluster.FirstTriangle * 3, Cluster.TrianglesNum * 3);
+		}
+		FMemory::Memcpy(Indices.GetData(), NewIndices.GetData(), NewIndices.Num() * sizeof(uint32));
+	}
+
+	/// Optimizes the triangles order of each section, then sorts its vertices
+	/// in the order the triangles use them.
+	void OptimizeSections(FRuntimeSkeletalMeshLODData& LODData)
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(Optimize);
+
+		// The vertices are moved, so keep track of the surface vertex they come
+		// from.
+		if (LODData.SourceVertices.Num() == 0)
+		{
+			// No section was split, so each section covers its whole surface.
+			LODData.SourceVertices.SetNumUninitialized(LODData.StaticVertices.Num());
+			for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+			{
+				for (uint32 I = 0; I < Section.NumVertices; I += 1)
+				{
+					LODData.SourceVertices[Section.BaseVertexIndex + I] = I;
+				}
+			}
+		}
+
+		ParallelFor(LODData.Sections.Num(), [&](const int32 SectionIndex)
+		{
+			const FRuntimeSkeletalMeshSection& Section = LODData.Sections[SectionIndex];
+			const TArrayView<uint32> Indices(LODData.Indices.GetData() + Section.BaseIndex, Section.NumTriangles * 3);
+			const int32 VerticesNum = Section.NumVertices;
+
+			// Work with the section relative indices.
+			for (uint32& Index : Indices)
+			{
+				Index -= Section.BaseVertexIndex;
+			}
+
+			OptimizeVertexCache(Indices, VerticesNum);
+			OptimizeOverdraw(Indices, LODData.StaticVertices.GetData() + Section.BaseVertexIndex, VerticesNum);
+
+			// The vertices are sorted by first use; the unused ones go last.
+			TArray<int32> VertexRemap;
+			VertexRemap.Init(INDEX_NONE, VerticesNum);
+			int32 NextVertex = 0;
+			for (uint32& Index : Indices)
+			{
+				if (VertexRemap[Index] == INDEX_NONE)
+				{
+					VertexRemap[Index] = NextVertex;
+					NextVertex += 1;
+				}
+				Index = VertexRemap[Index] + Section.BaseVertexIndex;
+			}
+			for (int32& NewVertex : VertexRemap)
+			{
+				if (NewVertex == INDEX_NONE)
+				{
+					NewVertex = NextVertex;
+					NextVertex += 1;
+				}
+			}
+
+			const TArray<FStaticMeshBuildVertex> OldStaticVertices(LODData.StaticVertices.GetData() + Section.BaseVertexIndex, VerticesNum);
+			const TArray<FSkinWeightInfo> OldWeights(LODData.Weights.GetData() + Section.BaseVertexIndex, VerticesNum);
+			const TArray<uint32> OldSourceVertices(LODData.SourceVertices.GetData() + Section.BaseVertexIndex, VerticesNum);
+			for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex += 1)
+			{
+				const uint32 NewVertexIndex = Section.BaseVertexIndex + VertexRemap[VertexIndex];
+				LODData.StaticVertices[NewVertexIndex] = OldStaticVertices[VertexIndex];
+				LODData.Weights[NewVertexIndex] = OldWeights[VertexIndex];
+				LODData.SourceVertices[NewVertexIndex] = OldSourceVertices[VertexIndex];
+			}
+		});
+	}
+
+#if WITH_EDITORONLY_DATA
+	/// Adds the materials of the sections to the `ImportedModelData`.
+	void AddImportedModelMaterials(
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		FRuntimeSkeletalMeshLODData& LODData)
+	{
+		FSkeletalMeshImportData& ImportedModelData = LODData.ImportedModelData;
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			// The assignment of the material here is not necessarily correct. I wonder if an error will occur if the SurfacesMaterial is empty.
+			if (Section.MaterialIndex >= 0 && Section.MaterialIndex < SurfacesMaterial.Num())
+			{
+				if (Section.MaterialIndex >= ImportedModelData.Materials.Num())
+				{
+					SkeletalMeshImportData::FMaterial& NewMaterial = ImportedModelData.Materials.AddDefaulted_GetRef();
+					NewMaterial.Material = SurfacesMaterial[Section.MaterialIndex];
+					NewMaterial.MaterialImportName = SurfacesMaterial[Section.MaterialIndex]->GetFullName();
+				}
+			}
+		}
+	}
+
+	/// Initialize the `ImportedModelData` from the already packed buffers: this
+	/// is used by the editor during reload time.
+	void BuildImportedModelData(
+		const FReferenceSkeleton& RefSkeleton,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const TMap<FName, FTransform>& BoneTransformsOverride,
+		FRuntimeSkeletalMeshLODData& LODData)
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(ImportData);
+
+		const TArray<FStaticMeshBuildVertex>& StaticVertices = LODData.StaticVertices;
+		const TArray<FSkinWeightInfo>& Weights = LODData.Weights;
+		const TArray<uint32>& Indices = LODData.Indices;
+
+		FSkeletalMeshImportData& ImportedModelData = LODData.ImportedModelData;
+		ImportedModelData = FSkeletalMeshImportData();
+
+		// The surface each vertex belongs to.
+		TArray<int32> VertexSurfaceIndex;
+		VertexSurfaceIndex.SetNumZeroed(StaticVertices.Num());
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			for (uint32 VertexIndex = 0; VertexIndex < Section.NumVertices; VertexIndex += 1)
+			{
+				VertexSurfaceIndex[Section.BaseVertexIndex + VertexIndex] = Section.SurfaceIndex;
+			}
+		}
+
+		ImportedModelData.Points.SetNum(StaticVertices.Num());
+		for (int32 i = 0; i < StaticVertices.Num(); i++)
+		{
+			ImportedModelData.Points[i] = StaticVertices[i].Position;
+		}
+
+		// Existing points map 1:1
+		ImportedModelData.PointToRawMap.AddUninitialized(ImportedModelData.Points.Num());
+		for (int32 i = 0; i < ImportedModelData.Points.Num(); i++)
+		{
+			ImportedModelData.PointToRawMap[i] = i;
+		}
+		check(ImportedModelData.PointToRawMap.Num() == StaticVertices.Num());
+
+		AddImportedModelMaterials(SurfacesMaterial, LODData);
+
+		ImportedModelData.Faces.SetNum(Indices.Num() / 3);
+		ParallelFor(ImportedModelData.Faces.Num(), [&](const int32 FaceIndex)
+		{
+			SkeletalMeshImportData::FTriangle& Triangle = ImportedModelData.Faces[FaceIndex];
+
+			const int32 VertexIndex0 = Indices[FaceIndex * 3 + 0];
+			const int32 VertexIndex1 = Indices[FaceIndex * 3 + 1];
+			const int32 VertexIndex2 = Indices[FaceIndex * 3 + 2];
+			Triangle.WedgeIndex[0] = FaceIndex * 3 + 0;
+			Triangle.WedgeIndex[1] = FaceIndex * 3 + 1;
+			Triangle.WedgeIndex[2] = FaceIndex * 3 + 2;
+
+			Triangle.TangentX[0] = StaticVertices[VertexIndex0].TangentX;
+			Triangle.TangentY[0] = StaticVertices[VertexIndex0].TangentY;
+			Triangle.TangentZ[0] = StaticVertices[VertexIndex0].TangentZ;
+
+			Triangle.TangentX[1] = StaticVertices[VertexIndex1].TangentX;
+			Triangle.TangentY[1] = StaticVertices[VertexIndex1].TangentY;
+			Triangle.TangentZ[1] = StaticVertices[VertexIndex1].TangentZ;
+
+			Triangle.TangentX[2] = StaticVertices[VertexIndex2].TangentX;
+			Triangle.TangentY[2] = StaticVertices[VertexIndex2].TangentY;
+			Triangle.TangentZ[2] = StaticVertices[VertexIndex2].TangentZ;
+
+			Triangle.MatIndex = VertexSurfaceIndex[VertexIndex0];
+			Triangle.AuxMatIndex = 0;
+			Triangle.SmoothingGroups = 1; // TODO Calculate the smoothing group correctly, otherwise everything will be smooth
+		});
+
+		ImportedModelData.Wedges.SetNum(ImportedModelData.Faces.Num() * 3);
+		ParallelFor(ImportedModelData.Faces.Num(), [&](const int32 FaceIndex)
+		{
+			for (int32 i = 0; i < 3; i += 1)
+			{
+				const int32 WedgeIndex = FaceIndex * 3 + i;
+				const int32 VertexIndex = Indices[WedgeIndex];
+
+				ImportedModelData.Wedges[WedgeIndex].VertexIndex = VertexIndex;
+				for (int32 UVIndex = 0; UVIndex < FMath::Min<int32>(MAX_TEXCOORDS, MAX_STATIC_TEXCOORDS); ++UVIndex)
+				{
+					ImportedModelData.Wedges[WedgeIndex].UVs[UVIndex] = StaticVertices[VertexIndex].UVs[UVIndex];
+				}
+				ImportedModelData.Wedges[WedgeIndex].MatIndex = VertexSurfaceIndex[VertexIndex];
+				ImportedModelData.Wedges[WedgeIndex].Color = StaticVertices[VertexIndex].Color;
+				ImportedModelData.Wedges[WedgeIndex].Reserved = 0;
+			}
+		});
+
+		{
+			const int32 BoneNum = RefSkeleton.GetRawBoneNum();
+			SkeletalMeshImportData::FBone DefaultBone;
+			DefaultBone.Name = FString(TEXT(""));
+			DefaultBone.Flags = 0;
+			DefaultBone.NumChildren = 0;
+			DefaultBone.ParentIndex = INDEX_NONE;
+			DefaultBone.BonePos.Transform.SetIdentity();
+			DefaultBone.BonePos.Length = 0.0;
+			DefaultBone.BonePos.XSize = 1.0;
+			DefaultBone.BonePos.YSize = 1.0;
+			DefaultBone.BonePos.ZSize = 1.0;
+			ImportedModelData.RefBonesBinary.Init(DefaultBone, BoneNum);
+			for (int32 i = 0; i < BoneNum; i += 1)
+			{
+				ImportedModelData.RefBonesBinary[i].Name = RefSkeleton.GetBoneName(i).ToString();
+				ImportedModelData.RefBonesBinary[i].ParentIndex = RefSkeleton.GetParentIndex(i);
+				if (ImportedModelData.RefBonesBinary[i].ParentIndex != INDEX_NONE)
+				{
+					// Increase parent children count by 1
+					ImportedModelData.RefBonesBinary[ImportedModelData.RefBonesBinary[i].ParentIndex].NumChildren += 1;
+				}
+			}
+
+			// At this point it's certain all the bones are initialized, finish the process
+			// by setting the local transform.
+			for (int32 i = 0; i < BoneNum; i += 1)
+			{
+				// Relative to its parent.
+				const FTransform* TransformOverride = BoneTransformsOverride.Find(RefSkeleton.GetBoneName(i));
+				if (TransformOverride != nullptr)
+				{
+					ImportedModelData.RefBonesBinary[i].BonePos.Transform = FTransform3f(*TransformOverride);
+				}
+				else
+				{
+					ImportedModelData.RefBonesBinary[i].BonePos.Transform = FTransform3f(RefSkeleton.GetRawRefBonePose()[i]);
+				}
+				// Set the Bone Length.
+				ImportedModelData.RefBonesBinary[i].BonePos.Length = ImportedModelData.RefBonesBinary[i].BonePos.Transform.GetLocation().Size();
+			}
+		}
+
+		// The skin weights store the section bone index: map it back to the
+		// skeleton bone index.
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			for (uint32 I = 0; I < Section.NumVertices; I += 1)
+			{
+				const uint32 VertexIndex = Section.BaseVertexIndex + I;
+				const FSkinWeightInfo& Weight = Weights[VertexIndex];
+				for (int InfluenceIndex = 0; InfluenceIndex < LODData.MaxBoneInfluences; InfluenceIndex++)
+				{
+					if (Weight.InfluenceWeights[InfluenceIndex] != 0)
+					{
+						SkeletalMeshImportData::FRawBoneInfluence& Influence = ImportedModelData.Influences.AddDefaulted_GetRef();
+						Influence.Weight = static_cast<float>(FMath::Clamp(Weight.InfluenceWeights[InfluenceIndex] / 65535.0, 0.0, 1.0));
+						Influence.BoneIndex = Section.BoneMap[Weight.InfluenceBones[InfluenceIndex]];
+						Influence.VertexIndex = VertexIndex;
+					}
+				}
+			}
+		}
+
+		ImportedModelData.NumTexCoords = LODData.UVCount;
+		ImportedModelData.MaxMaterialIndex = LODData.SurfaceVertexOffsets.Num() - 1;
+		ImportedModelData.bHasVertexColors = LODData.bHasVertexColors;
+		ImportedModelData.bHasNormals = true;
+		ImportedModelData.bHasTangents = true;
+		ImportedModelData.bUseT0AsRefPose = false;
+		ImportedModelData.bDiffPose = false;
+	}
+#endif
+}
+
+FPackedMeshSurface::FPackedMeshSurface(const FMeshSurface& Surface)
+	: MaterialIndex(Surface.MaterialIndex)
+{
+	const int32 VertexNum = Surface.Vertices.Num();
+
+	UVChannels = Surface.Uvs.Num() > 0 ? Surface.Uvs[0].Num() : 0;
+	for (const TArray<FRawBoneInfluence>& Influences : Surface.BoneInfluences)
+	{
+		InfluenceSlots = FMath::Max(Influences.Num(), InfluenceSlots);
+	}
+
+	Indices = Surface.Indices;
+	Colors = Surface.Colors;
+	FlipBinormalSigns = Surface.FlipBinormalSigns;
+
+	Vertices.SetNumUninitialized(VertexNum);
+	Tangents.SetNumUninitialized(VertexNum);
+	Normals.SetNumUninitialized(VertexNum);
+	Uvs.SetNumZeroed(VertexNum * UVChannels);
+	InfluenceBones.SetNumZeroed(VertexNum * InfluenceSlots);
+	InfluenceWeights.SetNumZeroed(VertexNum * InfluenceSlots);
+
+	for (int32 VertexIndex = 0; VertexIndex < VertexNum; VertexIndex += 1)
+	{
+		Vertices[VertexIndex] = FVector3f(Surface.Vertices[VertexIndex]);
+		Tangents[VertexIndex] = FVector3f(Surface.Tangents[VertexIndex]);
+		Normals[VertexIndex] = FVector3f(Surface.Normals[VertexIndex]);
+
+		if (UVChannels > 0)
+		{
+			const TArray<FVector2D>& VertexUvs = Surface.Uvs[VertexIndex];
+			for (int32 UVIndex = 0; UVIndex < FMath::Min(UVChannels, VertexUvs.Num()); UVIndex += 1)
+			{
+				Uvs[VertexIndex * UVChannels + UVIndex] = FVector2f(VertexUvs[UVIndex]);
+			}
+		}
+	}
+
+	for (int32 VertexIndex = 0; VertexIndex < Surface.BoneInfluences.Num(); VertexIndex += 1)
+	{
+		const TArray<FRawBoneInfluence>& VertInfluences = Surface.BoneInfluences[VertexIndex];
+		for (int32 InfluenceIndex = 0; InfluenceIndex < VertInfluences.Num(); InfluenceIndex += 1)
+		{
+			// Make sure these are the same.
+			check(VertexIndex == VertInfluences[InfluenceIndex].VertexIndex);
+
+			InfluenceBones[VertexIndex * InfluenceSlots + InfluenceIndex] = static_cast<FBoneIndexType>(VertInfluences[InfluenceIndex].BoneIndex);
+			InfluenceWeights[VertexIndex * InfluenceSlots + InfluenceIndex] = VertInfluences[InfluenceIndex].Weight;
+		}
+	}
+}
+
+void FPackedMeshSurface::ToMeshSurface(FMeshSurface& OutSurface) const
+{
+	const int32 VertexNum = Vertices.Num();
+
+	OutSurface.MaterialIndex = MaterialIndex;
+	OutSurface.Indices = Indices;
+	OutSurface.Colors = Colors;
+	OutSurface.FlipBinormalSigns = FlipBinormalSigns;
+
+	OutSurface.Vertices.SetNum(VertexNum);
+	OutSurface.Tangents.SetNum(VertexNum);
+	OutSurface.Normals.SetNum(VertexNum);
+	OutSurface.Uvs.SetNum(VertexNum);
+	OutSurface.BoneInfluences.SetNum(VertexNum);
+
+	for (int32 VertexIndex = 0; VertexIndex < VertexNum; VertexIndex += 1)
+	{
+		OutSurface.Vertices[VertexIndex] = FVector(Vertices[VertexIndex]);
+		OutSurface.Tangents[VertexIndex] = FVector(Tangents[VertexIndex]);
+		OutSurface.Normals[VertexIndex] = FVector(Normals[VertexIndex]);
+
+		OutSurface.Uvs[VertexIndex].SetNum(UVChannels);
+		for (int32 UVIndex = 0; UVIndex < UVChannels; UVIndex += 1)
+		{
+			OutSurface.Uvs[VertexIndex][UVIndex] = FVector2D(Uvs[VertexIndex * UVChannels + UVIndex]);
+		}
+
+		OutSurface.BoneInfluences[VertexIndex].SetNum(InfluenceSlots);
+		for (int32 InfluenceIndex = 0; InfluenceIndex < InfluenceSlots; InfluenceIndex += 1)
+		{
+			OutSurface.BoneInfluences[VertexIndex][InfluenceIndex] = FRawBoneInfluence(
+				VertexIndex,
+				InfluenceBones[VertexIndex * InfluenceSlots + InfluenceIndex],
+				InfluenceWeights[VertexIndex * InfluenceSlots + InfluenceIndex]);
+		}
+	}
+}
+
+bool FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(
+	USkeletalMesh* SkeletalMesh,
+	const TArray<FMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	FRuntimeSkeletalMeshLODData LODData;
+	if (!BuildSkeletalMeshLODData(
+		SkeletalMesh->GetSkeleton()->GetReferenceSkeleton(),
+		Surfaces,
+		SurfacesMaterial,
+		BoneTransformsOverride,
+		LODData,
+		BuildOptions))
+	{
+		return false;
+	}
+
+	return CommitSkeletalMesh(
+		SkeletalMesh,
+		MakeArrayView(&LODData, 1),
+		SurfacesMaterial,
+		bNeedCPUAccess);
+}
+
+bool FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(
+	USkeletalMesh* SkeletalMesh,
+	const TArray<FPackedMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	FRuntimeSkeletalMeshLODData LODData;
+	if (!BuildSkeletalMeshLODData(
+		SkeletalMesh->GetSkeleton()->GetReferenceSkeleton(),
+		Surfaces,
+		SurfacesMaterial,
+		BoneTransformsOverride,
+		LODData,
+		BuildOptions))
+	{
+		return false;
+	}
+
+	return CommitSkeletalMesh(
+		SkeletalMesh,
+		MakeArrayView(&LODData, 1),
+		SurfacesMaterial,
+		bNeedCPUAccess);
+}
+
+bool FRuntimeSkeletalMeshGenerator::GenerateSkeletalMesh(
+	USkeletalMesh* SkeletalMesh,
+	const TArray<FMeshLOD>& LODs,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	if (LODs.Num() == 0)
+	{
+		return false;
+	}
+
+	const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton();
+
+	// Each LOD is independent, so build them all at once.
+	TArray<FRuntimeSkeletalMeshLODData> LODsData;
+	LODsData.SetNum(LODs.Num());
+	TArray<bool> Built;
+	Built.Init(false, LODs.Num());
+	ParallelFor(LODs.Num(), [&](int32 LODIndex)
+	{
+		Built[LODIndex] = BuildSkeletalMeshLODData(
+			RefSkeleton,
+			LODs[LODIndex].Surfaces,
+			SurfacesMaterial,
+			BoneTransformsOverride,
+			LODsData[LODIndex],
+			BuildOptions);
+		LODsData[LODIndex].ScreenSize = LODs[LODIndex].ScreenSize;
+		LODsData[LODIndex].LODHysteresis = LODs[LODIndex].LODHysteresis;
+	});
+
+	if (Built.Contains(false))
+	{
+		return false;
+	}
+
+	return CommitSkeletalMesh(
+		SkeletalMesh,
+		LODsData,
+		SurfacesMaterial,
+		bNeedCPUAccess);
+}
+
+TFuture<bool> FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshAsync(
+	USkeletalMesh* SkeletalMesh,
+	TArray<FMeshSurface> Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FOnRuntimeSkeletalMeshGenerated OnGenerated,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	return GenerateSkeletalMeshAsync_Internal(
+		SkeletalMesh,
+		[Surfaces = MoveTemp(Surfaces), BoneTransformsOverride, BuildOptions](const FReferenceSkeleton& RefSkeleton, TArray<FRuntimeSkeletalMeshLODData>& OutLODs)
+		{
+			return BuildSkeletalMeshLODData(
+				RefSkeleton,
+				Surfaces,
+				TArray<UMaterialInterface*>(),
+				BoneTransformsOverride,
+				OutLODs.AddDefaulted_GetRef(),
+				BuildOptions);
+		},
+		SurfacesMaterial,
+		bNeedCPUAccess,
+		MoveTemp(OnGenerated));
+}
+
+TFuture<bool> FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshAsync(
+	USkeletalMesh* SkeletalMesh,
+	TArray<FPackedMeshSurface> Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FOnRuntimeSkeletalMeshGenerated OnGenerated,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	return GenerateSkeletalMeshAsync_Internal(
+		SkeletalMesh,
+		[Surfaces = MoveTemp(Surfaces), BoneTransformsOverride, BuildOptions](const FReferenceSkeleton& RefSkeleton, TArray<FRuntimeSkeletalMeshLODData>& OutLODs)
+		{
+			return BuildSkeletalMeshLODData(
+				RefSkeleton,
+				Surfaces,
+				TArray<UMaterialInterface*>(),
+				BoneTransformsOverride,
+				OutLODs.AddDefaulted_GetRef(),
+				BuildOptions);
+		},
+		SurfacesMaterial,
+		bNeedCPUAccess,
+		MoveTemp(OnGenerated));
+}
+
+TFuture<bool> FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshAsync(
+	USkeletalMesh* SkeletalMesh,
+	TArray<FMeshLOD> LODs,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FOnRuntimeSkeletalMeshGenerated OnGenerated,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	if (LODs.Num() == 0)
+	{
+		SkeletalMesh = nullptr;
+	}
+
+	return GenerateSkeletalMeshAsync_Internal(
+		SkeletalMesh,
+		[LODs = MoveTemp(LODs), BoneTransformsOverride, BuildOptions](const FReferenceSkeleton& RefSkeleton, TArray<FRuntimeSkeletalMeshLODData>& OutLODs)
+		{
+			// Each LOD is independent, so build them all at once, as the sync path.
+			OutLODs.SetNum(LODs.Num());
+			TArray<bool> Built;
+			Built.Init(false, LODs.Num());
+			ParallelFor(LODs.Num(), [&](int32 LODIndex)
+			{
+				Built[LODIndex] = BuildSkeletalMeshLODData(
+					RefSkeleton,
+					LODs[LODIndex].Surfaces,
+					TArray<UMaterialInterface*>(),
+					BoneTransformsOverride,
+					OutLODs[LODIndex],
+					BuildOptions);
+				OutLODs[LODIndex].ScreenSize = LODs[LODIndex].ScreenSize;
+				OutLODs[LODIndex].LODHysteresis = LODs[LODIndex].LODHysteresis;
+			});
+			return !Built.Contains(false);
+		},
+		SurfacesMaterial,
+		bNeedCPUAccess,
+		MoveTemp(OnGenerated));
+}
+
+TFuture<bool> FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshAsync_Internal(
+	USkeletalMesh* SkeletalMesh,
+	TUniqueFunction<bool(const FReferenceSkeleton&, TArray<FRuntimeSkeletalMeshLODData>&)> BuildLODs,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	FOnRuntimeSkeletalMeshGenerated OnGenerated)
+{
+	check(IsInGameThread());
+
+	TSharedRef<TPromise<bool>> Promise = MakeShared<TPromise<bool>>();
+	TFuture<bool> Future = Promise->GetFuture();
+
+	if (!SkeletalMesh || !SkeletalMesh->GetSkeleton())
+	{
+		Promise->SetValue(false);
+		OnGenerated.ExecuteIfBound(false);
+		return Future;
+	}
+
+	// Copy the reference skeleton, so the worker never touches the `USkeleton`.
+	FReferenceSkeleton RefSkeleton = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton();
+
+	// The materials are not referenced while the LODs are built: they are
+	// resolved back on the game thread, and the build fails if one is gone.
+	TArray<TWeakObjectPtr<UMaterialInterface>> WeakSurfacesMaterial;
+	WeakSurfacesMaterial.Reserve(SurfacesMaterial.Num());
+	for (UMaterialInterface* Material : SurfacesMaterial)
+	{
+		WeakSurfacesMaterial.Emplace(Material);
+	}
+
+	AsyncTask(
+		ENamedThreads::AnyBackgroundThreadNormalTask,
+		[
+			WeakSkeletalMesh = TWeakObjectPtr<USkeletalMesh>(SkeletalMesh),
+			RefSkeleton = MoveTemp(RefSkeleton),
+			BuildLODs = MoveTemp(BuildLODs),
+			WeakSurfacesMaterial = MoveTemp(WeakSurfacesMaterial),
+			bNeedCPUAccess,
+			OnGenerated = MoveTemp(OnGenerated),
+			Promise
+		]() mutable
+		{
+			TSharedRef<TArray<FRuntimeSkeletalMeshLODData>> LODsData = MakeShared<TArray<FRuntimeSkeletalMeshLODData>>();
+			const bool bBuilt = BuildLODs(RefSkeleton, *LODsData);
+
+			// The `UObject` handoff must happen on the game thread.
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[
+					WeakSkeletalMesh,
+					LODsData,
+					WeakSurfacesMaterial = MoveTemp(WeakSurfacesMaterial),
+					bNeedCPUAccess,
+					OnGenerated = MoveTemp(OnGenerated),
+					Promise,
+					bBuilt
+				]()
+				{
+					USkeletalMesh* SkeletalMesh = WeakSkeletalMesh.Get();
+
+					TArray<UMaterialInterface*> SurfacesMaterial;
+					SurfacesMaterial.Reserve(WeakSurfacesMaterial.Num());
+					bool bMaterialsValid = true;
+					for (const TWeakObjectPtr<UMaterialInterface>& WeakMaterial : WeakSurfacesMaterial)
+					{
+						if (WeakMaterial.IsStale())
+						{
+							bMaterialsValid = false;
+						}
+						SurfacesMaterial.Add(WeakMaterial.Get());
+					}
+					if (!bMaterialsValid)
+					{
+						UE_LOG(LogTemp, Warning, TEXT("A material was destroyed while the mesh was being built."));
+					}
+
+#if WITH_EDITORONLY_DATA
+					if (bBuilt && bMaterialsValid)
+					{
+						for (FRuntimeSkeletalMeshLODData& LODData : *LODsData)
+						{
+							AddImportedModelMaterials(SurfacesMaterial, LODData);
+						}
+					}
+#endif
+
+					const bool bSuccess =
+						bBuilt &&
+						bMaterialsValid &&
+						SkeletalMesh != nullptr &&
+						CommitSkeletalMesh(SkeletalMesh, *LODsData, SurfacesMaterial, bNeedCPUAccess);
+
+					Promise->SetValue(bSuccess);
+					OnGenerated.ExecuteIfBound(bSuccess);
+				});
+		});
+
+	return Future;
+}
+
+bool FRuntimeSkeletalMeshGenerator::BuildSkeletalMeshLODData(
+	const FReferenceSkeleton& RefSkeleton,
+	const TArray<FMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FRuntimeSkeletalMeshLODData& OutLODData,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	TArray<FPackedMeshSurface> PackedSurfaces;
+	PackedSurfaces.Reserve(Surfaces.Num());
+	for (const FMeshSurface& Surface : Surfaces)
+	{
+		PackedSurfaces.Emplace(Surface);
+	}
+
+	return BuildSkeletalMeshLODData(
+		RefSkeleton,
+		PackedSurfaces,
+		SurfacesMaterial,
+		BoneTransformsOverride,
+		OutLODData,
+		BuildOptions);
+}
+
+bool FRuntimeSkeletalMeshGenerator::BuildSkeletalMeshLODData(
+	const FReferenceSkeleton& RefSkeleton,
+	const TArray<FPackedMeshSurface>& Surfaces,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FRuntimeSkeletalMeshLODData& OutLODData,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	if (Surfaces.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<uint32>& SurfaceVertexOffsets = OutLODData.SurfaceVertexOffsets;
+	TArray<uint32>& SurfaceIndexOffsets = OutLODData.SurfaceIndexOffsets;
+	SurfaceVertexOffsets.SetNum(Surfaces.Num());
+	SurfaceIndexOffsets.SetNum(Surfaces.Num());
+
+	int32 MaxBoneInfluences = 0;
+	const int32 UVCount = Surfaces[0].UVChannels;
+
+	const EParallelForFlags PackFlags = BuildOptions.bParallelPack
+		? EParallelForFlags::None
+		: EParallelForFlags::ForceSingleThread;
+
+	// Collect all the vertices and index for each surface.
+	TArray<FStaticMeshBuildVertex>& StaticVertices = OutLODData.StaticVertices;
+	TArray<FSkinWeightInfo>& Weights = OutLODData.Weights;
+	TArray<uint32>& Indices = OutLODData.Indices;
+	{
+		// First count all the vertices.
+		uint32 VerticesCount = 0;
+		uint32 IndicesCount = 0;
+		{
+			RUNTIME_SKELETAL_MESH_PHASE(Count);
+
+			for (int32 I = 0; I < Surfaces.Num(); I++)
+			{
+				const FPackedMeshSurface& Surface = Surfaces[I];
+
+				SurfaceVertexOffsets[I] = VerticesCount;
+				SurfaceIndexOffsets[I] = IndicesCount;
+				VerticesCount += Surface.Vertices.Num();
+				IndicesCount += Surface.Indices.Num();
+				MaxBoneInfluences = FMath::Max(Surface.InfluenceSlots, MaxBoneInfluences);
+
+				// Unreal doesn't support more than `MAX_TOTAL_INFLUENCES` BoneInfluences.
+				check(Surface.InfluenceSlots <= MAX_TOTAL_INFLUENCES);
+
+				// Make sure all the surfaces have the same amount of UVs.
+				check(UVCount == Surface.UVChannels);
+				check(Surface.Uvs.Num() == Surface.Vertices.Num() * Surface.UVChannels);
+				check(Surface.InfluenceBones.Num() == Surface.Vertices.Num() * Surface.InfluenceSlots);
+				check(Surface.InfluenceWeights.Num() == Surface.InfluenceBones.Num());
+			}
+		}
+
+		{
+			RUNTIME_SKELETAL_MESH_PHASE(Pack);
+
+			StaticVertices.SetNumZeroed(VerticesCount);
+			Weights.SetNumZeroed(VerticesCount);
+			Indices.SetNumUninitialized(IndicesCount);
+
+			// Now that the offsets are known, each vertex is independent: pack them
+			// in parallel.
+			const TArray<FSurfaceTaskRange> VertexTasks = MakeSurfaceTaskRanges(
+				Surfaces.Num(),
+				[&](const int32 SurfaceIndex) { return Surfaces[SurfaceIndex].Vertices.Num(); });
+
+			TArray<FBox3f> TasksBounds;
+			TasksBounds.Init(FBox3f(ForceInit), VertexTasks.Num());
+
+			ParallelFor(VertexTasks.Num(), [&](const int32 TaskIndex)
+			{
+				const FSurfaceTaskRange& Task = VertexTasks[TaskIndex];
+				const FPackedMeshSurface& Surface = Surfaces[Task.SurfaceIndex];
+				const uint32 VerticesOffset = SurfaceVertexOffsets[Task.SurfaceIndex];
+
+				for (int32 VertexIndex = Task.Begin; VertexIndex < Task.End; VertexIndex += 1)
+				{
+					FStaticMeshBuildVertex& StaticVertex = StaticVertices[VerticesOffset + VertexIndex];
+					if (Surface.Colors.Num() > 0)
+					{
+						StaticVertex.Color = Surface.Colors[VertexIndex];
+					}
+					StaticVertex.Position = Surface.Vertices[VertexIndex];
+					StaticVertex.TangentX = Surface.Tangents[VertexIndex];
+					StaticVertex.TangentY = FVector3f::CrossProduct(Surface.Normals[VertexIndex], Surface.Tangents[VertexIndex]) * (Surface.FlipBinormalSigns[VertexIndex] ? -1.0f : 1.0f);
+					StaticVertex.TangentZ = Surface.Normals[VertexIndex];
+					for(int32 UVIndex = 0; UVIndex < UVCount; ++UVIndex)
+					{
+						StaticVertex.UVs[UVIndex] = Surface.Uvs[VertexIndex * UVCount + UVIndex];
+					}
+
+					// Set Bounding boxes
+					TasksBounds[TaskIndex] += Surface.Vertices[VertexIndex];
+
+					// Note: When this surface has less influences than the whole Mesh, the
+					// remaining ones are left to 0. This happens when the user submits
+					// surfaces with different bone weights.
+					FSkinWeightInfo& Weight = Weights[VerticesOffset + VertexIndex];
+					for (int InfluenceIndex = 0; InfluenceIndex < Surface.InfluenceSlots; InfluenceIndex++)
+					{
+						const int32 Slot = VertexIndex * Surface.InfluenceSlots + InfluenceIndex;
+						const FBoneIndexType BoneIndex = Surface.InfluenceBones[Slot];
+
+						if (!RefSkeleton.IsValidIndex(BoneIndex))
+						{
+							// This bone appear to be invalid, continue.
+							UE_LOG(LogTemp, Warning, TEXT("The bone %i isn't found in this skeleton"), BoneIndex);
+							continue;
+						}
+
+						// Convert 0.0 - 1.0 range to 0 - 65535
+						const uint16 EncodedWeight = FMath::Clamp(Surface.InfluenceWeights[Slot], 0.f, 1.f) * 65535;
+						Weight.InfluenceWeights[InfluenceIndex] = EncodedWeight;
+						Weight.InfluenceBones[InfluenceIndex] = EncodedWeight == 0 ? 0 : BoneIndex;
+					}
+					if (BuildOptions.bSanitizeBoneWeights)
+					{
+						SanitizeBoneWeights(Weight, BuildOptions.MaxInfluencesPerVertex, BuildOptions.MinBoneWeight);
+					}
+					if (!BuildOptions.bUseHighPrecisionBoneWeights)
+					{
+						QuantizeBoneWeightsTo8Bit(Weight);
+					}
+				}
+			}, PackFlags);
+
+			for (const FBox3f& TaskBounds : TasksBounds)
+			{
+				OutLODData.Bounds += FBox(TaskBounds);
+			}
+		}
+
+		// Convert the Indices to Global.
+		{
+			RUNTIME_SKELETAL_MESH_PHASE(Indices);
+
+			const TArray<FSurfaceTaskRange> IndexTasks = MakeSurfaceTaskRanges(
+				Surfaces.Num(),
+				[&](const int32 SurfaceIndex) { return Surfaces[SurfaceIndex].Indices.Num(); });
+
+			ParallelFor(IndexTasks.Num(), [&](const int32 TaskIndex)
+			{
+				const FSurfaceTaskRange& Task = IndexTasks[TaskIndex];
+				const FPackedMeshSurface& Surface = Surfaces[Task.SurfaceIndex];
+				const uint32 VerticesOffset = SurfaceVertexOffsets[Task.SurfaceIndex];
+				const uint32 IndicesOffset = SurfaceIndexOffsets[Task.SurfaceIndex];
+
+				for (int32 IndicesIndex = Task.Begin; IndicesIndex < Task.End; IndicesIndex++)
+				{
+					Indices[IndicesOffset + IndicesIndex] = Surface.Indices[IndicesIndex] + VerticesOffset;
+				}
+			}, PackFlags);
+
+			// The source indices identify the topology, that the vertices updates
+			// must keep.
+			OutLODData.SurfaceIndicesHashes.SetNumUninitialized(Surfaces.Num());
+			ParallelFor(Surfaces.Num(), [&](const int32 SurfaceIndex)
+			{
+				const TArray<uint32>& SurfaceIndices = Surfaces[SurfaceIndex].Indices;
+				OutLODData.SurfaceIndicesHashes[SurfaceIndex] = FXxHash64::HashBuffer(SurfaceIndices.GetData(), SurfaceIndices.Num() * sizeof(uint32)).Hash;
+			}, PackFlags);
+		}
+	}
+
+	// Unreal doesn't support more than `MAX_TOTAL_INFLUENCES` BoneInfluences.
+	check(MaxBoneInfluences <= MAX_TOTAL_INFLUENCES);
+
+	// Unreal doesn't support more than `MAX_STATIC_TEXCOORDS`.
+	check(UVCount <= MAX_STATIC_TEXCOORDS);
+
+	OutLODData.UVCount = UVCount;
+	OutLODData.MaxBoneInfluences = MaxBoneInfluences;
+	OutLODData.bHasVertexColors = Surfaces[0].Colors.Num() > 0;
+	OutLODData.bUseFullPrecisionUVs = BuildOptions.bUseFullPrecisionUVs;
+	OutLODData.bUseHighPrecisionTangentBasis = BuildOptions.bUseHighPrecisionTangentBasis;
+	OutLODData.bUseHighPrecisionBoneWeights = BuildOptions.bUseHighPrecisionBoneWeights;
+
+	OutLODData.Sections.SetNum(Surfaces.Num());
+	for (int32 I = 0; I < Surfaces.Num(); I++)
+	{
+		FRuntimeSkeletalMeshSection& Section = OutLODData.Sections[I];
+		Section.SurfaceIndex = I;
+		Section.MaterialIndex = Surfaces[I].MaterialIndex;
+		Section.BaseVertexIndex = SurfaceVertexOffsets[I];
+		Section.NumVertices = Surfaces[I].Vertices.Num();
+		Section.BaseIndex = SurfaceIndexOffsets[I];
+		Section.NumTriangles = Surfaces[I].Indices.Num() / 3;
+	}
+
+	ComputeSectionsMaxBoneInfluences(OutLODData);
+
+	if (BuildOptions.bWeldVertices)
+	{
+		WeldSectionsVertices(OutLODData, BuildOptions);
+	}
+
+	BuildSectionsBoneMap(
+		OutLODData,
+		RefSkeleton.GetRawBoneNum(),
+		FGPUBaseSkinVertexFactory::GetMaxGPUSkinBones());
+
+	if (BuildOptions.bOptimizeIndices)
+	{
+		OptimizeSections(OutLODData);
+	}
+
+	if (BuildOptions.bMergeSectionsByMaterial)
+	{
+		MergeSectionsByMaterial(
+			OutLODData,
+			RefSkeleton.GetRawBoneNum(),
+			FGPUBaseSkinVertexFactory::GetMaxGPUSkinBones());
+	}
+
+	if (BuildOptions.bBuildDuplicatedVertices)
+	{
+		BuildSectionsDuplicatedVertices(OutLODData, BuildOptions.WeldPositionTolerance);
+	}
+
+#if WITH_EDITORONLY_DATA
+	BuildImportedModelData(RefSkeleton, SurfacesMaterial, BoneTransformsOverride, OutLODData);
+#endif
+
+	int64 SectionBones = 0;
+	for (const FRuntimeSkeletalMeshSection& Section : OutLODData.Sections)
+	{
+		SectionBones += Section.BoneMap.Num();
+	}
+	const int64 AllocatedBytes =
+		OutLODData.StaticVertices.GetAllocatedSize()
+		+ OutLODData.Weights.GetAllocatedSize()
+		+ OutLODData.Indices.GetAllocatedSize()
+		+ OutLODData.SourceVertices.GetAllocatedSize();
+
+	INC_DWORD_STAT_BY(STAT_RuntimeSkeletalMesh_Vertices, OutLODData.StaticVertices.Num());
+	INC_DWORD_STAT_BY(STAT_RuntimeSkeletalMesh_IndicesNum, OutLODData.Indices.Num());
+	INC_DWORD_STAT_BY(STAT_RuntimeSkeletalMesh_Sections, OutLODData.Sections.Num());
+	INC_DWORD_STAT_BY(STAT_RuntimeSkeletalMesh_SectionBones, SectionBones);
+	INC_DWORD_STAT_BY(STAT_RuntimeSkeletalMesh_AllocatedBytes, AllocatedBytes);
+
+	GeneratorStats.BuiltLODs += 1;
+	GeneratorStats.Vertices += OutLODData.StaticVertices.Num();
+	GeneratorStats.Indices += OutLODData.Indices.Num();
+	GeneratorStats.Sections += OutLODData.Sections.Num();
+	GeneratorStats.SectionBones += SectionBones;
+	GeneratorStats.AllocatedBytes += AllocatedBytes;
+
+	return true;
+}
+
+bool FRuntimeSkeletalMeshGenerator::UpdateSkeletalMeshLODData(
+	const FReferenceSkeleton& RefSkeleton,
+	FMeshSurfacesUpdate Update,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FRuntimeSkeletalMeshLODData& InOutLODData,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	const FRuntimeSkeletalMeshLODData& OldLODData = InOutLODData;
+	const int32 OldSurfacesNum = OldLODData.SurfaceVertexOffsets.Num();
+
+	if (OldLODData.bMergedSections)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The surfaces of a LOD built with `bMergeSectionsByMaterial` share their sections, build the LOD again instead."));
+		return false;
+	}
+	if (!OldLODData.VertexStreams.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The LOD keeps its vertices encoded, build the LOD again instead."));
+		return false;
+	}
+
+	TArray<bool> Removed;
+	Removed.Init(false, OldSurfacesNum);
+	for (const int32 SurfaceIndex : Update.Remove)
+	{
+		if (!Removed.IsValidIndex(SurfaceIndex) || Update.Replace.Contains(SurfaceIndex))
+		{
+			return false;
+		}
+		Removed[SurfaceIndex] = true;
+	}
+
+	// Build only the changed surfaces: the replaced ones first, then the added.
+	TArray<FPackedMeshSurface> ChangedSurfaces;
+	ChangedSurfaces.Reserve(Update.Replace.Num() + Update.Add.Num());
+	TArray<int32> ReplacedBy;
+	ReplacedBy.Init(INDEX_NONE, OldSurfacesNum);
+	for (TPair<int32, FPackedMeshSurface>& Replaced : Update.Replace)
+	{
+		if (!ReplacedBy.IsValidIndex(Replaced.Key))
+		{
+			return false;
+		}
+		ReplacedBy[Replaced.Key] = ChangedSurfaces.Add(MoveTemp(Replaced.Value));
+	}
+	const int32 FirstAddedSurface = ChangedSurfaces.Num();
+	ChangedSurfaces.Append(MoveTemp(Update.Add));
+
+	FRuntimeSkeletalMeshLODData ChangedLODData;
+	if (ChangedSurfaces.Num() > 0)
+	{
+		// The surfaces are moved one by one, so each needs its own sections, and
+		// their vertices are copied as they are, so they must have the layout
+		// of the existing ones.
+		FRuntimeSkeletalMeshBuildOptions SurfacesBuildOptions = BuildOptions;
+		SurfacesBuildOptions.bMergeSectionsByMaterial = false;
+		SurfacesBuildOptions.bUseFullPrecisionUVs = OldLODData.bUseFullPrecisionUVs;
+		SurfacesBuildOptions.bUseHighPrecisionTangentBasis = OldLODData.bUseHighPrecisionTangentBasis;
+		SurfacesBuildOptions.bUseHighPrecisionBoneWeights = OldLODData.bUseHighPrecisionBoneWeights;
+		if (!BuildSkeletalMeshLODData(RefSkeleton, ChangedSurfaces, SurfacesMaterial, BoneTransformsOverride, ChangedLODData, SurfacesBuildOptions))
+		{
+			return false;
+		}
+
+		if (ChangedLODData.UVCount != OldLODData.UVCount)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("The updated surfaces must have the same amount of UVs of the existing ones."));
+			return false;
+		}
+	}
+
+	// A piece is a surface of the updated LOD, that comes either from the old
+	// LOD or from the changed one.
+	struct FPiece
+	{
+		const FRuntimeSkeletalMeshLODData* Source = nullptr;
+		int32 SourceSurfaceIndex = INDEX_NONE;
+		uint32 SourceVertexBegin = 0;
+		uint32 SourceIndexBegin = 0;
+		uint32 VertexBegin = 0;
+		uint32 IndexBegin = 0;
+		uint32 VerticesNum = 0;
+		uint32 IndicesNum = 0;
+	};
+
+	TArray<FPiece> Pieces;
+	Pieces.Reserve(OldSurfacesNum + ChangedSurfaces.Num());
+	uint32 VerticesCount = 0;
+	uint32 IndicesCount = 0;
+	auto AddPiece = [&](const FRuntimeSkeletalMeshLODData& Source, const int32 SurfaceIndex)
+	{
+		const int32 SourceSurfacesNum = Source.SurfaceVertexOffsets.Num();
+		FPiece& Piece = Pieces.AddDefaulted_GetRef();
+		Piece.Source = &Source;
+		Piece.SourceSurfaceIndex = SurfaceIndex;
+		Piece.SourceVertexBegin = Source.SurfaceVertexOffsets[SurfaceIndex];
+		Piece.SourceIndexBegin = Source.SurfaceIndexOffsets[SurfaceIndex];
+		Piece.VerticesNum = (SurfaceIndex + 1 < SourceSurfacesNum ? Source.SurfaceVertexOffsets[SurfaceIndex + 1] : Source.StaticVertices.Num()) - Piece.SourceVertexBegin;
+		Piece.IndicesNum = (SurfaceIndex + 1 < SourceSurfacesNum ? Source.SurfaceIndexOffsets[SurfaceIndex + 1] : Source.Indices.Num()) - Piece.SourceIndexBegin;
+		Piece.VertexBegin = VerticesCount;
+		Piece.IndexBegin = IndicesCount;
+		VerticesCount += Piece.VerticesNum;
+		IndicesCount += Piece.IndicesNum;
+	};
+
+	for (int32 SurfaceIndex = 0; SurfaceIndex < OldSurfacesNum; SurfaceIndex += 1)
+	{
+		if (Removed[SurfaceIndex])
+		{
+			continue;
+		}
+		if (ReplacedBy[SurfaceIndex] != INDEX_NONE)
+		{
+			AddPiece(ChangedLODData, ReplacedBy[SurfaceIndex]);
+		}
+		else
+		{
+			AddPiece(OldLODData, SurfaceIndex);
+		}
+	}
+	for (int32 SurfaceIndex = FirstAddedSurface; SurfaceIndex < ChangedSurfaces.Num(); SurfaceIndex += 1)
+	{
+		AddPiece(ChangedLODData, SurfaceIndex);
+	}
+
+	if (Pieces.Num() == 0)
+	{
+		// A mesh without surfaces can't be generated.
+		return false;
+	}
+
+	FRuntimeSkeletalMeshLODData NewLODData;
+	NewLODData.StaticVertices.SetNumUninitialized(VerticesCount);
+	NewLODData.Weights.SetNumUninitialized(VerticesCount);
+	NewLODData.Indices.SetNumUninitialized(IndicesCount);
+	NewLODData.SurfaceVertexOffsets.SetNum(Pieces.Num());
+	NewLODData.SurfaceIndexOffsets.SetNum(Pieces.Num());
+	NewLODData.SurfaceIndicesHashes.SetNum(Pieces.Num());
+	const bool bHasSourceVertices = OldLODData.SourceVertices.Num() > 0 || ChangedLODData.SourceVertices.Num() > 0;
+	if (bHasSourceVertices)
+	{
+		NewLODData.SourceVertices.SetNumUninitialized(VerticesCount);
+	}
+
+	// The buffers of each surface are copied as they are: only the indices of
+	// the moved surfaces need to be rebased.
+	ParallelFor(Pieces.Num(), [&](const int32 PieceIndex)
+	{
+		const FPiece& Piece = Pieces[PieceIndex];
+		FMemory::Memcpy(
+			NewLODData.StaticVertices.GetData() + Piece.VertexBegin,
+			Piece.Source->StaticVertices.GetData() + Piece.SourceVertexBegin,
+			Piece.VerticesNum * sizeof(FStaticMeshBuildVertex));
+		FMemory::Memcpy(
+			NewLODData.Weights.GetData() + Piece.VertexBegin,
+			Piece.Source->Weights.GetData() + Piece.SourceVertexBegin,
+			Piece.VerticesNum * sizeof(FSkinWeightInfo));
+
+		if (bHasSourceVertices)
+		{
+			for (uint32 I = 0; I < Piece.VerticesNum; I += 1)
+			{
+				NewLODData.SourceVertices[Piece.VertexBegin + I] = Piece.Source->SourceVertices.Num() > 0
+					? Piece.Source->SourceVertices[Piece.SourceVertexBegin + I]
+					: I;
+			}
+		}
+
+		const uint32* SourceIndices = Piece.Source->Indices.GetData() + Piece.SourceIndexBegin;
+		uint32* Indices = NewLODData.Indices.GetData() + Piece.IndexBegin;
+		if (Piece.VertexBegin == Piece.SourceVertexBegin)
+		{
+			FMemory::Memcpy(Indices, SourceIndices, Piece.IndicesNum * sizeof(uint32));
+		}
+		else
+		{
+			const uint32 Delta = Piece.VertexBegin - Piece.SourceVertexBegin;
+			for (uint32 I = 0; I < Piece.IndicesNum; I += 1)
+			{
+				Indices[I] = SourceIndices[I] + Delta;
+			}
+		}
+	});
+
+	// Each surface owns one or more sections, that keep their `BoneMap`.
+	int32 MaxSectionBones = 0;
+	for (int32 PieceIndex = 0; PieceIndex < Pieces.Num(); PieceIndex += 1)
+	{
+		const FPiece& Piece = Pieces[PieceIndex];
+		NewLODData.SurfaceVertexOffsets[PieceIndex] = Piece.VertexBegin;
+		NewLODData.SurfaceIndexOffsets[PieceIndex] = Piece.IndexBegin;
+		if (Piece.Source->SurfaceIndicesHashes.IsValidIndex(Piece.SourceSurfaceIndex))
+		{
+			NewLODData.SurfaceIndicesHashes[PieceIndex] = Piece.Source->SurfaceIndicesHashes[Piece.SourceSurfaceIndex];
+		}
+
+		for (const FRuntimeSkeletalMeshSection& SourceSection : Piece.Source->Sections)
+		{
+			if (SourceSection.SurfaceIndex != Piece.SourceSurfaceIndex)
+			{
+				continue;
+			}
+			FRuntimeSkeletalMeshSection& Section = NewLODData.Sections.Add_GetRef(SourceSection);
+			Section.SurfaceIndex = PieceIndex;
+			Section.BaseVertexIndex = SourceSection.BaseVertexIndex - Piece.SourceVertexBegin + Piece.VertexBegin;
+			Section.BaseIndex = SourceSection.BaseIndex - Piece.SourceIndexBegin + Piece.IndexBegin;
+			MaxSectionBones = FMath::Max(MaxSectionBones, Section.BoneMap.Num());
+		}
+	}
+
+	TArray<FBox3f> PiecesBounds;
+	PiecesBounds.Init(FBox3f(ForceInit), Pieces.Num());
+	ParallelFor(Pieces.Num(), [&](const int32 PieceIndex)
+	{
+		const FPiece& Piece = Pieces[PieceIndex];
+		for (uint32 VertexIndex = Piece.VertexBegin; VertexIndex < Piece.VertexBegin + Piece.VerticesNum; VertexIndex += 1)
+		{
+			PiecesBounds[PieceIndex] += NewLODData.StaticVertices[VertexIndex].Position;
+		}
+	});
+	for (const FBox3f& PieceBounds : PiecesBounds)
+	{
+		NewLODData.Bounds += FBox(PieceBounds);
+	}
+
+	NewLODData.UVCount = OldLODData.UVCount;
+	NewLODData.MaxBoneInfluences = FMath::Max(OldLODData.MaxBoneInfluences, ChangedLODData.MaxBoneInfluences);
+	NewLODData.bUse16BitBoneIndex = MaxSectionBones > MAX_uint8 + 1;
+	NewLODData.bHasVertexColors = OldLODData.bHasVertexColors || ChangedLODData.bHasVertexColors;
+	NewLODData.bUseFullPrecisionUVs = OldLODData.bUseFullPrecisionUVs;
+	NewLODData.bUseHighPrecisionTangentBasis = OldLODData.bUseHighPrecisionTangentBasis;
+	NewLODData.bUseHighPrecisionBoneWeights = OldLODData.bUseHighPrecisionBoneWeights;
+	NewLODData.ScreenSize = OldLODData.ScreenSize;
+	NewLODData.LODHysteresis = OldLODData.LODHysteresis;
+
+#if WITH_EDITORONLY_DATA
+	BuildImportedModelData(RefSkeleton, SurfacesMaterial, BoneTransformsOverride, NewLODData);
+#endif
+
+	InOutLODData = MoveTemp(NewLODData);
+	return true;
+}
+
+bool FRuntimeSkeletalMeshGenerator::UpdateSkeletalMeshSurfaces(
+	USkeletalMesh* SkeletalMesh,
+	FRuntimeSkeletalMeshLODData& InOutLODData,
+	FMeshSurfacesUpdate Update,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	if (SkeletalMesh->GetLODNum() > 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The mesh has more LODs, that would be dropped: update each LOD data and commit them all instead."));
+		return false;
+	}
+
+	if (!UpdateSkeletalMeshLODData(
+		SkeletalMesh->GetSkeleton()->GetReferenceSkeleton(),
+		MoveTemp(Update),
+		SurfacesMaterial,
+		BoneTransformsOverride,
+		InOutLODData,
+		BuildOptions))
+	{
+		return false;
+	}
+
+	return CommitSkeletalMesh(
+		SkeletalMesh,
+		MakeArrayView(&InOutLODData, 1),
+		SurfacesMaterial,
+		bNeedCPUAccess);
+}
+
+namespace
+{
+	/// Packs the tangent basis the same way `FStaticMeshVertexBuffer` does:
+	/// `TangentX`, then `TangentZ` with the binormal sign in W.
+	template<typename FTangent>
+	void PackTangents(const TArray<FStaticMeshBuildVertex>& StaticVertices, TArray<uint8>& OutTangents)
+	{
+		OutTangents.SetNumUninitialized(StaticVertices.Num() * sizeof(FTangent) * 2);
+		FTangent* Tangents = reinterpret_cast<FTangent*>(OutTangents.GetData());
+		ParallelFor(StaticVertices.Num(), [&](const int32 VertexIndex)
+		{
+			const FStaticMeshBuildVertex& Vertex = StaticVertices[VertexIndex];
+			Tangents[VertexIndex * 2 + 0] = FTangent(Vertex.TangentX);
+			Tangents[VertexIndex * 2 + 1] = FTangent(FVector4f(Vertex.TangentZ, GetBasisDeterminantSign(FVector3d(Vertex.TangentX), FVector3d(Vertex.TangentY), FVector3d(Vertex.TangentZ))));
+		});
+	}
+}
+
+bool FRuntimeSkeletalMeshGenerator::UpdateSkeletalMeshVertices(
+	USkeletalMesh* SkeletalMesh,
+	FRuntimeSkeletalMeshLODData& InOutLODData,
+	const TArray<FPackedMeshSurface>& Surfaces,
+	const int32 LODIndex,
+	TConstArrayView<USkinnedMeshComponent*> Components)
+{
+	check(IsInGameThread());
+
+	FSkeletalMeshRenderData* MeshRenderData = SkeletalMesh->GetResourceForRendering();
+	if (MeshRenderData == nullptr || !MeshRenderData->LODRenderData.IsValidIndex(LODIndex))
+	{
+		return false;
+	}
+	FSkeletalMeshLODRenderData* LODRenderData = &MeshRenderData->LODRenderData[LODIndex];
+
+	if (!InOutLODData.VertexStreams.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The LOD keeps its vertices encoded, use `GenerateSkeletalMesh` instead."));
+		return false;
+	}
+
+	// The topology must be the one `InOutLODData` was built from.
+	const int32 VerticesNum = InOutLODData.StaticVertices.Num();
+	if (Surfaces.Num() != InOutLODData.SurfaceVertexOffsets.Num()
+		|| LODRenderData->GetNumVertices() != uint32(VerticesNum))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The surfaces don't match the generated mesh, use `GenerateSkeletalMesh` instead."));
+		return false;
+	}
+	TArray<uint32> SurfacesVerticesNum;
+	TArray<uint32> SurfacesIndicesNum;
+	GetSurfacesSize(InOutLODData, SurfacesVerticesNum, SurfacesIndicesNum);
+	for (int32 SurfaceIndex = 0; SurfaceIndex < Surfaces.Num(); SurfaceIndex += 1)
+	{
+		const FPackedMeshSurface& Surface = Surfaces[SurfaceIndex];
+		const uint32 IndicesNum = SurfacesIndicesNum[SurfaceIndex];
+		const uint32 SurfaceVerticesNum = SurfacesVerticesNum[SurfaceIndex];
+
+		// When a section was split or welded, its vertices count changes, so only
+		// the untouched surfaces must have the same vertices count. The indices
+		// must be the ones the surface was built from.
+		if (uint32(Surface.Indices.Num()) != IndicesNum
+			|| (InOutLODData.SurfaceIndicesHashes.IsValidIndex(SurfaceIndex)
+				&& FXxHash64::HashBuffer(Surface.Indices.GetData(), Surface.Indices.Num() * sizeof(uint32)).Hash != InOutLODData.SurfaceIndicesHashes[SurfaceIndex])
+			|| (InOutLODData.SourceVertices.Num() == 0 && uint32(Surface.Vertices.Num()) != SurfaceVerticesNum)
+			|| Surface.Tangents.Num() != Surface.Vertices.Num()
+			|| Surface.Normals.Num() != Surface.Vertices.Num()
+			|| Surface.FlipBinormalSigns.Num() != Surface.Vertices.Num())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("The surface %i doesn't match the generated mesh, use `GenerateSkeletalMesh` instead."), SurfaceIndex);
+			return false;
+		}
+	}
+
+	// Update the CPU side vertices, so they are ready for the next update.
+	const TArray<FSurfaceTaskRange> VertexTasks = MakeSurfaceTaskRanges(
+		Surfaces.Num(),
+		[&](const int32 SurfaceIndex) { return SurfacesVerticesNum[SurfaceIndex]; });
+
+	TArray<FBox3f> TasksBounds;
+	TasksBounds.Init(FBox3f(ForceInit), VertexTasks.Num());
+	TArray<bool> TasksValid;
+	TasksValid.Init(true, VertexTasks.Num());
+
+	// The GPU positions are gathered in the same pass, so the rendering thread
+	// has only to copy.
+	TArray<FVector3f> Positions;
+	Positions.SetNumUninitialized(VerticesNum);
+
+	ParallelFor(VertexTasks.Num(), [&](const int32 TaskIndex)
+	{
+		const FSurfaceTaskRange& Task = VertexTasks[TaskIndex];
+		const FPackedMeshSurface& Surface = Surfaces[Task.SurfaceIndex];
+		const uint32 SurfaceVertexOffset = InOutLODData.SurfaceVertexOffsets[Task.SurfaceIndex];
+
+		for (int32 I = Task.Begin; I < Task.End; I += 1)
+		{
+			const uint32 VertexIndex = SurfaceVertexOffset + I;
+			const int32 SourceVertex = InOutLODData.SourceVertices.Num() > 0
+				? InOutLODData.SourceVertices[VertexIndex]
+				: I;
+			if (!Surface.Vertices.IsValidIndex(SourceVertex))
+			{
+				TasksValid[TaskIndex] = false;
+				return;
+			}
+
+			FStaticMeshBuildVertex& StaticVertex = InOutLODData.StaticVertices[VertexIndex];
+			StaticVertex.Position = Surface.Vertices[SourceVertex];
+			StaticVertex.TangentX = Surface.Tangents[SourceVertex];
+			StaticVertex.TangentY = FVector3f::CrossProduct(Surface.Normals[SourceVertex], Surface.Tangents[SourceVertex]) * (Surface.FlipBinormalSigns[SourceVertex] ? -1.0f : 1.0f);
+			StaticVertex.TangentZ = Surface.Normals[SourceVertex];
+			Positions[VertexIndex] = StaticVertex.Position;
+			TasksBounds[TaskIndex] += StaticVertex.Position;
+		}
+	});
+
+	if (TasksValid.Contains(false))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The surfaces don't match the generated mesh, use `GenerateSkeletalMesh` instead."));
+		return false;
+	}
+
+	InOutLODData.Bounds.Init();
+	for (const FBox3f& TaskBounds : TasksBounds)
+	{
+		InOutLODData.Bounds += FBox(TaskBounds);
+	}
+
+	// The LOD 0 defines the mesh bounds, the other LODs can only grow them.
+	const FBox OldBounds = SkeletalMesh->GetImportedBounds().GetBox();
+	const FBox NewBounds = LODIndex == 0 ? InOutLODData.Bounds : OldBounds + InOutLODData.Bounds;
+	if (!NewBounds.Equals(OldBounds))
+	{
+		SkeletalMesh->SetImportedBounds(FBoxSphereBounds(NewBounds));
+	}
+
+	// The components keep the bounds they were registered with: refresh them
+	// when a vertex moved outside, so they are not culled or shadowed wrongly.
+	// They are left as they are when the bounds shrink, so a slider doesn't
+	// refresh the components at each step.
+	if (!OldBounds.IsInside(NewBounds))
+	{
+		for (USkinnedMeshComponent* Component : Components)
+		{
+			if (Component != nullptr && Component->GetSkinnedAsset() == SkeletalMesh && Component->IsRegistered())
+			{
+				Component->UpdateBounds();
+				Component->MarkRenderTransformDirty();
+			}
+		}
+	}
+
+	TArray<uint8> Tangents;
+	if (LODRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetUseHighPrecisionTangentBasis())
+	{
+		PackTangents<FPackedRGBA16N>(InOutLODData.StaticVertices, Tangents);
+	}
+	else
+	{
+		PackTangents<FPackedNormal>(InOutLODData.StaticVertices, Tangents);
+	}
+
+	// The CPU copy is kept only when the mesh was generated with `bNeedCPUAccess`,
+	// and it's updated because the game thread reads it (e.g.
+	// `FRuntimeSkeletalMeshView`, `DecomposeSkeletalMesh`, `MergeSkeletalMeshes`).
+	// Without CPU access the buffers drop their data once the RHI resources are
+	// initialized, so it's written only after that, on the rendering thread.
+	const FSkeletalMeshLODInfo* LODInfo = SkeletalMesh->GetLODInfo(LODIndex);
+	const bool bAllowCPUAccess = LODInfo != nullptr && LODInfo->bAllowCPUAccess;
+
+	ENQUEUE_RENDER_COMMAND(UpdateRuntimeSkeletalMeshVertices)(
+		[LODRenderData, bAllowCPUAccess, Positions = MoveTemp(Positions), Tangents = MoveTemp(Tangents)](FRHICommandListImmediate& RHICmdList)
+		{
+			FPositionVertexBuffer& PositionBuffer = LODRenderData->StaticVertexBuffers.PositionVertexBuffer;
+			FStaticMeshVertexBuffer& StaticMeshBuffer = LODRenderData->StaticVertexBuffers.StaticMeshVertexBuffer;
+			const uint32 PositionsSize = Positions.Num() * sizeof(FVector3f);
+
+			if (bAllowCPUAccess && PositionBuffer.GetAllowCPUAccess() && PositionBuffer.GetVertexData() != nullptr)
+			{
+				FMemory::Memcpy(PositionBuffer.GetVertexData(), Positions.GetData(), PositionsSize);
+			}
+			if (bAllowCPUAccess && StaticMeshBuffer.GetAllowCPUAccess() && StaticMeshBuffer.GetTangentData() != nullptr)
+			{
+				FMemory::Memcpy(StaticMeshBuffer.GetTangentData(), Tangents.GetData(), Tangents.Num());
+			}
+
+			if (PositionBuffer.VertexBufferRHI.IsValid())
+			{
+				void* Data = RHICmdList.LockBuffer(PositionBuffer.VertexBufferRHI, 0, PositionsSize, RLM_WriteOnly);
+				FMemory::Memcpy(Data, Positions.GetData(), PositionsSize);
+				RHICmdList.UnlockBuffer(PositionBuffer.VertexBufferRHI);
+			}
+			if (StaticMeshBuffer.TangentsVertexBuffer.VertexBufferRHI.IsValid())
+			{
+				void* Data = RHICmdList.LockBuffer(StaticMeshBuffer.TangentsVertexBuffer.VertexBufferRHI, 0, Tangents.Num(), RLM_WriteOnly);
+				FMemory::Memcpy(Data, Tangents.GetData(), Tangents.Num());
+				RHICmdList.UnlockBuffer(StaticMeshBuffer.TangentsVertexBuffer.VertexBufferRHI);
+			}
+		});
+
+	return true;
+}
+
+bool FRuntimeSkeletalMeshGenerator::CommitSkeletalMesh(
+	USkeletalMesh* SkeletalMesh,
+	TConstArrayView<FRuntimeSkeletalMeshLODData> LODs,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess)
+{
+	check(IsInGameThread());
+
+	if (LODs.Num() == 0)
+	{
+		return false;
+	}
+
+	if (SkeletalMesh->GetResourceForRendering() != nullptr)
+	{
+		// This `SkeletalMesh` was already generated, and the rendering thread may
+		// still use its resources: wait until they are released.
+		// A freshly created `SkeletalMesh` doesn't need this, so the rendering
+		// thread is never flushed in the common case.
+		SkeletalMesh->ReleaseResources();
+		FlushRenderingCommands();
+	}
+
+	// Populate Arrays step.
+	SkeletalMesh->AllocateResourceForRendering();
+	FSkeletalMeshRenderData* MeshRenderData = SkeletalMesh->GetResourceForRendering();
+
+	SkeletalMesh->ResetLODInfo();
+#if WITH_EDITORONLY_DATA
+	SkeletalMesh->GetImportedModel()->LODModels.Empty();
+#endif
+
+	// Set Bounding boxes
+	FBox BoundingBox(ForceInit);
+	for (int32 LODIndex = 0; LODIndex < LODs.Num(); LODIndex += 1)
+	{
+		CommitLOD(SkeletalMesh, LODIndex, LODs[LODIndex], bNeedCPUAccess);
+		BoundingBox += LODs[LODIndex].Bounds;
+	}
+	SkeletalMesh->SetImportedBounds(FBoxSphereBounds(BoundingBox));
+
+	// Set the default Material.
+	SkeletalMesh->GetMaterials().Empty(SurfacesMaterial.Num());
+	for (auto& Material : SurfacesMaterial)
+	{
+		SkeletalMesh->GetMaterials().Emplace(Material);
+	}
+
+	// Rebuild inverse ref pose matrices.
+	SkeletalMesh->GetRefBasesInvMatrix().Empty();
+	SkeletalMesh->CalculateInvRefMatrices(); 
+	MeshRenderData->bReadyForStreaming = false;
+
+	// Suspected Finalization step
+	if (!GIsEditor)
+	{
+		SkeletalMesh->NeverStream = false;
+	}
+	if(bNeedCPUAccess)
+	{
+		SkeletalMesh->NeverStream = true;
+	}
+
+#if WITH_EDITOR
+	if (SkeletalMesh->GetLODSettings() != nullptr)
+	{
+		// update mapping information on the class
+		SkeletalMesh->GetLODSettings()->SetLODSettingsFromMesh(SkeletalMesh);
+
+		checkf(SkeletalMesh->GetLODSettings() != nullptr, TEXT("At this point the LODSetings are supposed to be set."));
+
+		const int32 NumSettings = FMath::Min(SkeletalMesh->GetLODSettings()->GetNumberOfSettings(), SkeletalMesh->GetLODNum());
+		checkf(0 < NumSettings, TEXT("Make sure the LODSettings are set for the LODIndex 0."));
+
+		for (int32 LODIndex = 0; LODIndex < NumSettings; LODIndex += 1)
+		{
+			const FSkeletalMeshLODGroupSettings* SkeletalMeshLODGroupSettings = &SkeletalMesh->GetLODSettings()->GetSettingsForLODLevel(LODIndex);
+			FSkeletalMeshLODInfo* MeshLodInfo = SkeletalMesh->GetLODInfo(LODIndex);
+			MeshLodInfo->BuildGUID = MeshLodInfo->ComputeDeriveDataCacheKey(SkeletalMeshLODGroupSettings);
+		}
+	}
+
+	SkeletalMesh->InvalidateDeriveDataCacheGUID();
+#endif
+
+	// Calls InitResources.
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(PostLoad);
+		SkeletalMesh->PostLoad();
+	}
+	GeneratorStats.CommittedMeshes += 1;
+
+#if WITH_EDITOR
+	// Signals to editor we are done with our changes
+	// This is to prevent the editor variable changes overwriting the import mesh,
+	// if you don't set this random crashes occur.
+	SkeletalMesh->StackPostEditChange();
+#endif
+	return true;
+}
+
+void FRuntimeSkeletalMeshGenerator::CommitLOD(
+	USkeletalMesh* SkeletalMesh,
+	const int32 LODIndex,
+	const FRuntimeSkeletalMeshLODData& LODData,
+	const bool bNeedCPUAccess)
+{
+	const TArray<FStaticMeshBuildVertex>& StaticVertices = LODData.StaticVertices;
+	const FRuntimeSkeletalMeshVertexStreams& Streams = LODData.VertexStreams;
+	const TArray<uint32>& Indices = LODData.Indices;
+	const int32 UVCount = LODData.UVCount;
+	const int32 MaxBoneInfluences = LODData.MaxBoneInfluences;
+
+	FSkeletalMeshRenderData* MeshRenderData = SkeletalMesh->GetResourceForRendering();
+	check(MeshRenderData->LODRenderData.Num() == LODIndex);
+
+	FSkeletalMeshLODRenderData* LODMeshRenderData = new FSkeletalMeshLODRenderData;
+	MeshRenderData->LODRenderData.Add(LODMeshRenderData);
+
+	FSkeletalMeshLODInfo& MeshLodInfo = SkeletalMesh->AddLODInfo();
+	MeshLodInfo.LODHysteresis = LODData.LODHysteresis;
+	MeshLodInfo.ScreenSize = LODData.ScreenSize;
+	MeshLodInfo.bAllowCPUAccess = bNeedCPUAccess;
+	if(bNeedCPUAccess)
+	{
+		MeshLodInfo.SkinCacheUsage = ESkinCacheUsage::Disabled;
+		MeshLodInfo.bHasBeenSimplified = true;
+	}
+
+#if WITH_EDITORONLY_DATA
+	FSkeletalMeshLODModel* SkeletalMeshLODModel = new FSkeletalMeshLODModel();
+	SkeletalMesh->GetImportedModel()->LODModels.Add(SkeletalMeshLODModel);
+
+	SkeletalMeshLODModel->NumVertices = StaticVertices.Num();
+	SkeletalMeshLODModel->NumTexCoords = UVCount;
+
+	SkeletalMeshLODModel->Sections.SetNum(LODData.Sections.Num());
+	SkeletalMeshLODModel->MaxImportVertex = StaticVertices.Num() - 1;
+#endif
+
+	LODMeshRenderData->RenderSections.SetNum(LODData.Sections.Num());
+
+	for (int32 I = 0; I < LODData.Sections.Num(); I++)
+	{
+		const FRuntimeSkeletalMeshSection& Section = LODData.Sections[I];
+		FSkelMeshRenderSection& RenderSection = LODMeshRenderData->RenderSections[I];
+
+		RenderSection.bDisabled = false;
+		RenderSection.BaseVertexIndex = Section.BaseVertexIndex;
+		RenderSection.NumVertices = Section.NumVertices;
+		RenderSection.BaseIndex = Section.BaseIndex;
+		RenderSection.NumTriangles = Section.NumTriangles;
+		RenderSection.MaterialIndex = Section.MaterialIndex;
+		RenderSection.bCastShadow = true;
+		RenderSection.bRecomputeTangent = false;
+		RenderSection.MaxBoneInfluences = Section.MaxBoneInfluences > 0 ? Section.MaxBoneInfluences : MaxBoneInfluences;
+
+#if WITH_EDITOR
+		FSkelMeshSection& MeshSection = SkeletalMeshLODModel->Sections[I];
+		MeshSection.bDisabled = RenderSection.bDisabled;
+		MeshSection.bRecomputeTangent = RenderSection.bRecomputeTangent;
+		MeshSection.bCastShadow = RenderSection.bCastShadow;
+		MeshSection.BaseVertexIndex = RenderSection.BaseVertexIndex;
+		MeshSection.BaseIndex = RenderSection.BaseIndex;
+		MeshSection.MaterialIndex = RenderSection.MaterialIndex;
+		MeshSection.NumVertices = RenderSection.NumVertices;
+		MeshSection.NumTriangles = RenderSection.NumTriangles;
+		MeshSection.MaxBoneInfluences = RenderSection.MaxBoneInfluences;
+		MeshSection.bUse16BitBoneIndex = LODData.bUse16BitBoneIndex;
+		MeshSection.OriginalDataSectionIndex = I; // Section IDX for below lookup in user sections data
+
+		MeshSection.OverlappingVertices.Reset();
+		for (int32 v = 0; v < Section.DuplicatedVerticesIndex.Num(); v++)
+		{
+			const FIndexLengthPair& IndexLength = Section.DuplicatedVerticesIndex[v];
+			if (IndexLength.Length > 0)
+			{
+				TArray<int32>& Overlapping = MeshSection.OverlappingVertices.Add(v);
+				for (uint32 d = IndexLength.Index; d < IndexLength.Index + IndexLength.Length; d++)
+				{
+					Overlapping.Add(Section.DuplicatedVertices[d]);
+				}
+			}
+		}
+
+		MeshSection.SoftVertices.SetNum(Section.NumVertices);
+		ParallelFor(Section.NumVertices, [&](const int32 v)
+		{
+			const FStaticMeshBuildVertex& StaticVertex = StaticVertices[Section.BaseVertexIndex + v];
+			const FSkinWeightInfo& Weight = LODData.Weights[Section.BaseVertexIndex + v];
+
+			MeshSection.SoftVertices[v].Position = StaticVertex.Position;
+			MeshSection.SoftVertices[v].TangentX = StaticVertex.TangentX;
+			MeshSection.SoftVertices[v].TangentY = StaticVertex.TangentY;
+			MeshSection.SoftVertices[v].TangentZ = StaticVertex.TangentZ;
+			for (int32 UVIndex = 0; UVIndex < UVCount; ++UVIndex)
+			{
+				MeshSection.SoftVertices[v].UVs[UVIndex] = StaticVertex.UVs[UVIndex];
+			}
+			MeshSection.SoftVertices[v].Color = StaticVertex.Color;
+
+			FMemory::Memcpy(MeshSection.SoftVertices[v].InfluenceWeights, Weight.InfluenceWeights, sizeof(MeshSection.SoftVertices[v].InfluenceWeights));
+			FMemory::Memcpy(MeshSection.SoftVertices[v].InfluenceBones, Weight.InfluenceBones, sizeof(MeshSection.SoftVertices[v].InfluenceBones));
+		});
+
+		{
+			// In Editor, we want to make sure the data is in sync between
+			// `UserSectionsData` and RenderSections.
+			FSkelMeshSourceSectionUserData& UserSectionData = SkeletalMeshLODModel->UserSectionsData.FindOrAdd(I);
+			UserSectionData.bDisabled = MeshSection.bDisabled;
+			UserSectionData.bCastShadow = MeshSection.bCastShadow;
+			UserSectionData.bRecomputeTangent = MeshSection.bRecomputeTangent;
+			UserSectionData.RecomputeTangentsVertexMaskChannel = MeshSection.RecomputeTangentsVertexMaskChannel;
+			UserSectionData.GenerateUpToLodIndex = MeshSection.GenerateUpToLodIndex;
+
+			const bool IsRenderDataInSync =
+				UserSectionData.bDisabled == RenderSection.bDisabled &&
+				UserSectionData.bCastShadow == RenderSection.bCastShadow &&
+				UserSectionData.bRecomputeTangent == RenderSection.bRecomputeTangent &&
+				UserSectionData.RecomputeTangentsVertexMaskChannel == RenderSection.RecomputeTangentsVertexMaskChannel &&
+				UserSectionData.CorrespondClothAssetIndex == RenderSection.CorrespondClothAssetIndex &&
+				UserSectionData.ClothingData.AssetGuid == RenderSection.ClothingData.AssetGuid &&
+				UserSectionData.ClothingData.AssetLodIndex == RenderSection.ClothingData.AssetLodIndex;
+
+			check(IsRenderDataInSync); // this must always be true or unreal will choke.
+		}
+#endif
+
+		if (Section.DuplicatedVerticesIndex.Num() > 0)
+		{
+			RenderSection.DuplicatedVerticesBuffer.DupVertData.ResizeBuffer(Section.DuplicatedVertices.Num());
+			FMemory::Memcpy(
+				RenderSection.DuplicatedVerticesBuffer.DupVertData.GetDataPointer(),
+				Section.DuplicatedVertices.GetData(),
+				Section.DuplicatedVertices.Num() * sizeof(uint32));
+
+			RenderSection.DuplicatedVerticesBuffer.DupVertIndexData.ResizeBuffer(RenderSection.NumVertices);
+			FMemory::Memcpy(
+				RenderSection.DuplicatedVerticesBuffer.DupVertIndexData.GetDataPointer(),
+				Section.DuplicatedVerticesIndex.GetData(),
+				RenderSection.NumVertices * sizeof(FIndexLengthPair));
+		}
+		else
+		{
+			// This is used when you have no overlapping Vertices.
+			RenderSection.DuplicatedVerticesBuffer.DupVertData.ResizeBuffer(1);
+			uint8* VertData = RenderSection.DuplicatedVerticesBuffer.DupVertData.GetDataPointer();
+			FMemory::Memzero(VertData, sizeof(uint32) * RenderSection.DuplicatedVerticesBuffer.DupVertData.Num());
+
+			RenderSection.DuplicatedVerticesBuffer.DupVertIndexData.ResizeBuffer(RenderSection.NumVertices);
+			uint8* IndexData = RenderSection.DuplicatedVerticesBuffer.DupVertIndexData.GetDataPointer();
+			FMemory::Memzero(IndexData, RenderSection.NumVertices * sizeof(FIndexLengthPair));
+		}
+	}
+
+	// Set the Indices.
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(IndexBuffer);
+
+#if WITH_EDITOR
+		SkeletalMeshLODModel->IndexBuffer = Indices;
+#endif
+
+		LODMeshRenderData->MultiSizeIndexContainer.RebuildIndexBuffer(
+			// Dynamically chose the index buffer size.
+			Indices.Num() < MAX_uint16 ? sizeof(uint16) : sizeof(uint32),
+			Indices);
+
+		// Test our data is good and the renderer can access it.
 		TArray<uint32> ActualIndexBuffer;
 		LODMeshRenderData->MultiSizeIndexContainer.GetIndexBuffer(ActualIndexBuffer);
 		check(ActualIndexBuffer.Num() == Indices.Num());
 	}
 
 	// Set the Vertex now.
-	LODMeshRenderData->StaticVertexBuffers.PositionVertexBuffer.Init(
-		StaticVertices,
-		bNeedCPUAccess);
-	LODMeshRenderData->StaticVertexBuffers.ColorVertexBuffer.Init(
-		StaticVertices,
-		bNeedCPUAccess);
-	LODMeshRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.Init(
-		StaticVertices,
-		UVCount,
-		bNeedCPUAccess);
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(VertexBuffers);
+
+		FStaticMeshVertexBuffers& VertexBuffers = LODMeshRenderData->StaticVertexBuffers;
+		VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(LODData.bUseFullPrecisionUVs);
+		VertexBuffers.StaticMeshVertexBuffer.SetUseHighPrecisionTangentBasis(LODData.bUseHighPrecisionTangentBasis);
+		if (Streams.IsEmpty())
+		{
+			VertexBuffers.PositionVertexBuffer.Init(
+				StaticVertices,
+				bNeedCPUAccess);
+			VertexBuffers.ColorVertexBuffer.Init(
+				StaticVertices,
+				bNeedCPUAccess);
+			VertexBuffers.StaticMeshVertexBuffer.Init(
+				StaticVertices,
+				UVCount,
+				bNeedCPUAccess);
+		}
+		else
+		{
+			// The streams are already encoded as the buffers store them.
+			VertexBuffers.PositionVertexBuffer.Init(
+				Streams.Positions,
+				bNeedCPUAccess);
+			if (Streams.Colors.Num() > 0)
+			{
+				VertexBuffers.ColorVertexBuffer.InitFromColorArray(
+					Streams.Colors,
+					bNeedCPUAccess);
+			}
+			VertexBuffers.StaticMeshVertexBuffer.Init(
+				Streams.Positions.Num(),
+				UVCount,
+				bNeedCPUAccess);
+			FMemory::Memcpy(VertexBuffers.StaticMeshVertexBuffer.GetTangentData(), Streams.Tangents.GetData(), Streams.Tangents.Num());
+			if (Streams.TexCoords.Num() > 0)
+			{
+				FMemory::Memcpy(VertexBuffers.StaticMeshVertexBuffer.GetTexCoordData(), Streams.TexCoords.GetData(), Streams.TexCoords.Num());
+			}
+		}
+	}
 
 	LODMeshRenderData->SkinWeightVertexBuffer.SetMaxBoneInfluences(MaxBoneInfluences);
-	LODMeshRenderData->SkinWeightVertexBuffer.SetUse16BitBoneIndex(bUse16BitBoneIndex);
+	LODMeshRenderData->SkinWeightVertexBuffer.SetUse16BitBoneIndex(LODData.bUse16BitBoneIndex);
+	LODMeshRenderData->SkinWeightVertexBuffer.SetUse16BitBoneWeight(LODData.bUseHighPrecisionBoneWeights);
+
+	// Enables all the Bones of this skeleton, to avoid break the mesh.
+	const int32 BoneNum = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawBoneNum();
+	LODMeshRenderData->RequiredBones.SetNumUninitialized(BoneNum);
+	for (int32 BoneIndex = 0; BoneIndex < BoneNum; BoneIndex++)
+	{
+		LODMeshRenderData->RequiredBones[BoneIndex] = BoneIndex;
+	}
+	LODMeshRenderData->ActiveBoneIndices = LODMeshRenderData->RequiredBones;
+#if WITH_EDITOR
+	SkeletalMeshLODModel->RequiredBones = LODMeshRenderData->RequiredBones;
+	SkeletalMeshLODModel->ActiveBoneIndices = LODMeshRenderData->RequiredBones;
+#endif
+
+	// Each section uses only the bones its vertices reference.
+	for (int32 I = 0; I < LODData.Sections.Num(); I++)
+	{
+		FSkelMeshRenderSection& RenderSection = LODMeshRenderData->RenderSections[I];
+		RenderSection.BoneMap = LODData.Sections[I].BoneMap;
+#if WITH_EDITOR
+		FSkelMeshSection& MeshSection = SkeletalMeshLODModel->Sections[I];
+		MeshSection.BoneMap = RenderSection.BoneMap;
+#endif
+	}
+
+	// Set the skin weights.
+	{
+		RUNTIME_SKELETAL_MESH_PHASE(SkinWeights);
+
+		LODMeshRenderData->SkinWeightVertexBuffer.SetNeedsCPUAccess(bNeedCPUAccess);
+		if (Streams.IsEmpty())
+		{
+			LODMeshRenderData->SkinWeightVertexBuffer = LODData.Weights;
+		}
+		else
+		{
+			LODMeshRenderData->SkinWeightVertexBuffer.CopySkinWeightRawDataFromBuffer(
+				Streams.SkinWeights.GetData(),
+				Streams.Positions.Num());
+		}
+	}
+
+#if WITH_EDITOR
+	const FString BuildStringID = SkeletalMeshLODModel->GetLODModelDeriveDataKey();
+	SkeletalMeshLODModel->BuildStringID = BuildStringID;
+
+	// `SaveLODImportedData` needs a mutable copy.
+	FSkeletalMeshImportData ImportedModelData = LODData.ImportedModelData;
+	SkeletalMesh->SetLODImportedDataVersions(LODIndex, ESkeletalMeshGeoImportVersions::LatestVersion, ESkeletalMeshSkinningImportVersions::LatestVersion);
+	SkeletalMesh->SaveLODImportedData(LODIndex, ImportedModelData);
+#endif
+}
+
+namespace
+{
+	/// Identifies the blobs written by `SerializeSkeletalMeshLODData`.
+	constexpr uint32 LODDataMagic = 0x524B534D; // "RSKM"
+	/// Increase this every time the blob layout changes.
+	constexpr uint32 LODDataVersion = 8;
+
+	/// Appends POD values and arrays to a byte buffer.
+	struct FLODDataWriter
+	{
+		TArray<uint8>& Data;
+
+		template<typename T>
+		void Write(const T& Value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written.");
+			Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+		}
+
+		template<typename T>
+		void WriteArray(const TArray<T>& Array)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written.");
+			Write<uint32>(Array.Num());
+			Data.Append(reinterpret_cast<const uint8*>(Array.GetData()), Array.Num() * sizeof(T));
+		}
+	};
+
+	/// Reads back the values written by `FLODDataWriter`. The data may come
+	/// from a mapped file, so nothing is assumed about its alignment.
+	struct FLODDataReader
+	{
+		TConstArrayView<uint8> Data;
+		int64 Offset = 0;
+		bool bError = false;
+
+		template<typename T>
+		T Read()
+		{
+			T Value{};
+			if (Offset + int64(sizeof(T)) > Data.Num())
+			{
+				bError = true;
+				return Value;
+			}
+			FMemory::Memcpy(&Value, Data.GetData() + Offset, sizeof(T));
+			Offset += sizeof(T);
+			return Value;
+		}
+
+		template<typename T>
+		void ReadArray(TArray<T>& OutArray)
+		{
+			const uint32 Num = Read<uint32>();
+			const int64 Size = int64(Num) * sizeof(T);
+			if (bError || Offset + Size > Data.Num())
+			{
+				bError = true;
+				return;
+			}
+			OutArray.SetNumUninitialized(Num);
+			FMemory::Memcpy(OutArray.GetData(), Data.GetData() + Offset, Size);
+			Offset += Size;
+		}
+	};
+
+	/// Makes sure the deserialized data can't make the upload read out of the
+	/// buffers bounds.
+	bool IsLODDataValid(const FRuntimeSkeletalMeshLODData& LODData, const int32 BoneNum)
+	{
+		// The LODs with the encoded streams don't keep the decoded vertices.
+		const FRuntimeSkeletalMeshVertexStreams& Streams = LODData.VertexStreams;
+		const bool bHasStreams = !Streams.IsEmpty();
+		const uint32 VerticesNum = bHasStreams ? Streams.Positions.Num() : LODData.StaticVertices.Num();
+		const uint32 IndicesNum = LODData.Indices.Num();
+
+		if (VerticesNum == 0
+			|| (bHasStreams
+				? LODData.StaticVertices.Num() != 0 || LODData.Weights.Num() != 0
+				: LODData.Weights.Num() != LODData.StaticVertices.Num())
+			|| IndicesNum % 3 != 0
+			|| LODData.UVCount < 0 || LODData.UVCount > MAX_STATIC_TEXCOORDS
+			|| LODData.MaxBoneInfluences < 0 || LODData.MaxBoneInfluences > MAX_TOTAL_INFLUENCES
+			|| LODData.SurfaceVertexOffsets.Num() != LODData.SurfaceIndexOffsets.Num()
+			|| (LODData.SourceVertices.Num() != 0 && uint32(LODData.SourceVertices.Num()) != VerticesNum)
+			|| (LODData.SurfaceOrder.Num() != 0 && LODData.SurfaceOrder.Num() != LODData.SurfaceVertexOffsets.Num())
+			|| (LODData.SurfaceIndicesHashes.Num() != 0 && LODData.SurfaceIndicesHashes.Num() != LODData.SurfaceVertexOffsets.Num())
+			|| LODData.Sections.Num() == 0)
+		{
+			return false;
+		}
+
+		const uint32 SkinWeightsStride = GetSkinWeightsStride(LODData);
+		if (bHasStreams
+			&& (uint64(Streams.Tangents.Num()) != uint64(VerticesNum) * GetTangentsStride(LODData)
+				|| uint64(Streams.TexCoords.Num()) != uint64(VerticesNum) * GetTexCoordsStride(LODData)
+				|| (Streams.Colors.Num() != 0 && uint32(Streams.Colors.Num()) != VerticesNum)
+				|| uint64(Streams.SkinWeights.Num()) != uint64(VerticesNum) * SkinWeightsStride))
+		{
+			return false;
+		}
+
+		// The surfaces must follow each other in the buffers.
+		TArray<bool> SurfaceFound;
+		SurfaceFound.Init(false, LODData.SurfaceVertexOffsets.Num());
+		uint32 LastVertexOffset = 0;
+		uint32 LastIndexOffset = 0;
+		for (int32 I = 0; I < LODData.SurfaceVertexOffsets.Num(); I += 1)
+		{
+			const int32 SurfaceIndex = LODData.SurfaceOrder.Num() > 0 ? LODData.SurfaceOrder[I] : I;
+			if (!SurfaceFound.IsValidIndex(SurfaceIndex)
+				|| SurfaceFound[SurfaceIndex]
+				|| LODData.SurfaceVertexOffsets[SurfaceIndex] < LastVertexOffset
+				|| LODData.SurfaceVertexOffsets[SurfaceIndex] > VerticesNum
+				|| LODData.SurfaceIndexOffsets[SurfaceIndex] < LastIndexOffset
+				|| LODData.SurfaceIndexOffsets[SurfaceIndex] > IndicesNum)
+			{
+				return false;
+			}
+			SurfaceFound[SurfaceIndex] = true;
+			LastVertexOffset = LODData.SurfaceVertexOffsets[SurfaceIndex];
+			LastIndexOffset = LODData.SurfaceIndexOffsets[SurfaceIndex];
+		}
 
-	TArray<FSkinWeightInfo> Weights;
-	Weights.SetNum(Vertices.Num());
+		for (const uint32 Index : LODData.Indices)
+		{
+			if (Index >= VerticesNum)
+			{
+				return false;
+			}
+		}
+
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			if (!LODData.SurfaceVertexOffsets.IsValidIndex(Section.SurfaceIndex)
+				|| uint64(Section.BaseVertexIndex) + Section.NumVertices > VerticesNum
+				|| uint64(Section.BaseIndex) + uint64(Section.NumTriangles) * 3 > IndicesNum
+				|| Section.BoneMap.Num() == 0
+				|| Section.MaxBoneInfluences < 0 || Section.MaxBoneInfluences > LODData.MaxBoneInfluences
+				|| (Section.DuplicatedVerticesIndex.Num() != 0 && uint32(Section.DuplicatedVerticesIndex.Num()) != Section.NumVertices))
+			{
+				return false;
+			}
+			for (const FIndexLengthPair& IndexLength : Section.DuplicatedVerticesIndex)
+			{
+				if (uint64(IndexLength.Index) + IndexLength.Length > uint64(Section.DuplicatedVertices.Num()))
+				{
+					return false;
+				}
+			}
+			for (const uint32 DuplicatedVertex : Section.DuplicatedVertices)
+			{
+				if (DuplicatedVertex >= Section.NumVertices)
+				{
+					return false;
+				}
+			}
+			for (const FBoneIndexType Bone : Section.BoneMap)
+			{
+				if (Bone >= BoneNum)
+				{
+					return false;
+				}
+			}
+			for (uint32 VertexIndex = Section.BaseVertexIndex; VertexIndex < Section.BaseVertexIndex + Section.NumVertices; VertexIndex += 1)
+			{
+				const FSkinWeightInfo Weight = bHasStreams
+					? DecodeSkinWeight(
+						Streams.SkinWeights.GetData() + VertexIndex * SkinWeightsStride,
+						LODData.MaxBoneInfluences,
+						LODData.bUse16BitBoneIndex,
+						LODData.bUseHighPrecisionBoneWeights)
+					: LODData.Weights[VertexIndex];
+				for (int32 I = 0; I < MAX_TOTAL_INFLUENCES; I += 1)
+				{
+					if (Weight.InfluenceBones[I] >= Section.BoneMap.Num())
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+void FRuntimeSkeletalMeshGenerator::SerializeSkeletalMeshLODData(
+	TConstArrayView<FRuntimeSkeletalMeshLODData> LODs,
+	TArray<uint8>& OutData)
+{
+	OutData.Reset();
+
+	uint64 Size = 0;
+	for (const FRuntimeSkeletalMeshLODData& LODData : LODs)
+	{
+		Size += LODData.StaticVertices.Num() * sizeof(FStaticMeshBuildVertex);
+		Size += LODData.Weights.Num() * sizeof(FSkinWeightInfo);
+		Size += LODData.Indices.Num() * sizeof(uint32);
+		Size += LODData.VertexStreams.Positions.Num() * sizeof(FVector3f);
+		Size += LODData.VertexStreams.Tangents.Num();
+		Size += LODData.VertexStreams.TexCoords.Num();
+		Size += LODData.VertexStreams.Colors.Num() * sizeof(FColor);
+		Size += LODData.VertexStreams.SkinWeights.Num();
+		Size += 256;
+	}
+	OutData.Reserve(Size);
+
+	FLODDataWriter Writer{OutData};
+
+	// The buffers are stored as they are in memory: the layout of the
+	// structures is part of the format.
+	Writer.Write<uint32>(LODDataMagic);
+	Writer.Write<uint32>(LODDataVersion);
+	Writer.Write<uint32>(sizeof(FStaticMeshBuildVertex));
+	Writer.Write<uint32>(sizeof(FSkinWeightInfo));
+	Writer.Write<uint32>(LODs.Num());
+
+	for (const FRuntimeSkeletalMeshLODData& LODData : LODs)
+	{
+		Writer.Write<int32>(LODData.UVCount);
+		Writer.Write<int32>(LODData.MaxBoneInfluences);
+		Writer.Write<uint8>(LODData.bUse16BitBoneIndex);
+		Writer.Write<uint8>(LODData.bHasVertexColors);
+		Writer.Write<uint8>(LODData.bUseFullPrecisionUVs);
+		Writer.Write<uint8>(LODData.bUseHighPrecisionTangentBasis);
+		Writer.Write<uint8>(LODData.bUseHighPrecisionBoneWeights);
+		Writer.Write<uint8>(LODData.bMergedSections);
+		Writer.Write<float>(LODData.ScreenSize);
+		Writer.Write<float>(LODData.LODHysteresis);
+		Writer.Write<uint8>(LODData.Bounds.IsValid);
+		Writer.Write<FVector3d>(LODData.Bounds.Min);
+		Writer.Write<FVector3d>(LODData.Bounds.Max);
+
+		// The encoded streams replace the vertices: the editor decodes them on
+		// load.
+		if (LODData.VertexStreams.IsEmpty())
+		{
+			Writer.WriteArray(LODData.StaticVertices);
+			Writer.WriteArray(LODData.Weights);
+		}
+		else
+		{
+			Writer.Write<uint32>(0);
+			Writer.Write<uint32>(0);
+		}
+		Writer.WriteArray(LODData.Indices);
+		Writer.WriteArray(LODData.SurfaceVertexOffsets);
+		Writer.WriteArray(LODData.SurfaceIndexOffsets);
+		Writer.WriteArray(LODData.SourceVertices);
+		Writer.WriteArray(LODData.SurfaceOrder);
+		Writer.WriteArray(LODData.SurfaceIndicesHashes);
+		Writer.WriteArray(LODData.VertexStreams.Positions);
+		Writer.WriteArray(LODData.VertexStreams.Tangents);
+		Writer.WriteArray(LODData.VertexStreams.TexCoords);
+		Writer.WriteArray(LODData.VertexStreams.Colors);
+		Writer.WriteArray(LODData.VertexStreams.SkinWeights);
+
+		Writer.Write<uint32>(LODData.Sections.Num());
+		for (const FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			Writer.Write<int32>(Section.SurfaceIndex);
+			Writer.Write<int32>(Section.MaterialIndex);
+			Writer.Write<uint32>(Section.BaseVertexIndex);
+			Writer.Write<uint32>(Section.NumVertices);
+			Writer.Write<uint32>(Section.BaseIndex);
+			Writer.Write<uint32>(Section.NumTriangles);
+			Writer.Write<int32>(Section.MaxBoneInfluences);
+			Writer.WriteArray(Section.BoneMap);
+			Writer.WriteArray(Section.DuplicatedVertices);
+			Writer.WriteArray(Section.DuplicatedVerticesIndex);
+		}
+	}
+}
+
+bool FRuntimeSkeletalMeshGenerator::DeserializeSkeletalMeshLODData(
+	TConstArrayView<uint8> Data,
+	const FReferenceSkeleton& RefSkeleton,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	TArray<FRuntimeSkeletalMeshLODData>& OutLODs)
+{
+	OutLODs.Reset();
+
+	FLODDataReader Reader{Data};
+	if (Reader.Read<uint32>() != LODDataMagic
+		|| Reader.Read<uint32>() != LODDataVersion
+		|| Reader.Read<uint32>() != sizeof(FStaticMeshBuildVertex)
+		|| Reader.Read<uint32>() != sizeof(FSkinWeightInfo))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The skeletal mesh data was written by another version, it needs to be generated again."));
+		return false;
+	}
+
+	const uint32 LODNum = Reader.Read<uint32>();
+	if (Reader.bError || LODNum == 0 || LODNum > MAX_SKELETAL_MESH_LODS)
+	{
+		return false;
+	}
+
+	OutLODs.SetNum(LODNum);
+	for (FRuntimeSkeletalMeshLODData& LODData : OutLODs)
+	{
+		LODData.UVCount = Reader.Read<int32>();
+		LODData.MaxBoneInfluences = Reader.Read<int32>();
+		LODData.bUse16BitBoneIndex = Reader.Read<uint8>() != 0;
+		LODData.bHasVertexColors = Reader.Read<uint8>() != 0;
+		LODData.bUseFullPrecisionUVs = Reader.Read<uint8>() != 0;
+		LODData.bUseHighPrecisionTangentBasis = Reader.Read<uint8>() != 0;
+		LODData.bUseHighPrecisionBoneWeights = Reader.Read<uint8>() != 0;
+		LODData.bMergedSections = Reader.Read<uint8>() != 0;
+		LODData.ScreenSize = Reader.Read<float>();
+		LODData.LODHysteresis = Reader.Read<float>();
+		LODData.Bounds.IsValid = Reader.Read<uint8>();
+		LODData.Bounds.Min = Reader.Read<FVector3d>();
+		LODData.Bounds.Max = Reader.Read<FVector3d>();
+
+		Reader.ReadArray(LODData.StaticVertices);
+		Reader.ReadArray(LODData.Weights);
+		Reader.ReadArray(LODData.Indices);
+		Reader.ReadArray(LODData.SurfaceVertexOffsets);
+		Reader.ReadArray(LODData.SurfaceIndexOffsets);
+		Reader.ReadArray(LODData.SourceVertices);
+		Reader.ReadArray(LODData.SurfaceOrder);
+		Reader.ReadArray(LODData.SurfaceIndicesHashes);
+		Reader.ReadArray(LODData.VertexStreams.Positions);
+		Reader.ReadArray(LODData.VertexStreams.Tangents);
+		Reader.ReadArray(LODData.VertexStreams.TexCoords);
+		Reader.ReadArray(LODData.VertexStreams.Colors);
+		Reader.ReadArray(LODData.VertexStreams.SkinWeights);
+
+		const uint32 SectionsNum = Reader.Read<uint32>();
+		// Each section takes at least 7 `uint32`.
+		if (Reader.bError || int64(SectionsNum) * 7 * sizeof(uint32) > Reader.Data.Num() - Reader.Offset)
+		{
+			OutLODs.Reset();
+			return false;
+		}
+		LODData.Sections.SetNum(SectionsNum);
+		for (FRuntimeSkeletalMeshSection& Section : LODData.Sections)
+		{
+			Section.SurfaceIndex = Reader.Read<int32>();
+			Section.MaterialIndex = Reader.Read<int32>();
+			Section.BaseVertexIndex = Reader.Read<uint32>();
+			Section.NumVertices = Reader.Read<uint32>();
+			Section.BaseIndex = Reader.Read<uint32>();
+			Section.NumTriangles = Reader.Read<uint32>();
+			Section.MaxBoneInfluences = Reader.Read<int32>();
+			Reader.ReadArray(Section.BoneMap);
+			Reader.ReadArray(Section.DuplicatedVertices);
+			Reader.ReadArray(Section.DuplicatedVerticesIndex);
+		}
+
+		if (Reader.bError || !IsLODDataValid(LODData, RefSkeleton.GetRawBoneNum()))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("The skeletal mesh data is corrupted, or it doesn't match the skeleton."));
+			OutLODs.Reset();
+			return false;
+		}
+
+#if WITH_EDITORONLY_DATA
+		if (!LODData.VertexStreams.IsEmpty())
+		{
+			DecodeVertexStreams(LODData);
+		}
+		BuildImportedModelData(RefSkeleton, SurfacesMaterial, BoneTransformsOverride, LODData);
+#endif
+	}
+
+	return true;
+}
+
+bool FRuntimeSkeletalMeshGenerator::SaveSkeletalMeshLODData(
+	TConstArrayView<FRuntimeSkeletalMeshLODData> LODs,
+	const FString& Filename)
+{
+	TArray<uint8> Data;
+	SerializeSkeletalMeshLODData(LODs, Data);
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FRuntimeSkeletalMeshGenerator::LoadSkeletalMeshLODData(
+	const FString& Filename,
+	const FReferenceSkeleton& RefSkeleton,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	TArray<FRuntimeSkeletalMeshLODData>& OutLODs)
+{
+	// Map the file, so the buffers are copied straight from the page cache.
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedFile)
+	{
+		TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (MappedRegion)
+		{
+			return DeserializeSkeletalMeshLODData(
+				TConstArrayView<uint8>(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()),
+				RefSkeleton,
+				SurfacesMaterial,
+				BoneTransformsOverride,
+				OutLODs);
+		}
+	}
+
+	// This platform doesn't support memory mapped files.
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+	return DeserializeSkeletalMeshLODData(
+		Data,
+		RefSkeleton,
+		SurfacesMaterial,
+		BoneTransformsOverride,
+		OutLODs);
+}
+
+bool FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshFromFile(
+	USkeletalMesh* SkeletalMesh,
+	const FString& Filename,
+	const TArray<UMaterialInterface*>& SurfacesMaterial,
+	const bool bNeedCPUAccess,
+	const TMap<FName, FTransform>& BoneTransformsOverride)
+{
+	TArray<FRuntimeSkeletalMeshLODData> LODsData;
+	if (!LoadSkeletalMeshLODData(
+		Filename,
+		SkeletalMesh->GetSkeleton()->GetReferenceSkeleton(),
+		SurfacesMaterial,
+		BoneTransformsOverride,
+		LODsData))
+	{
+		return false;
+	}
+
+	return CommitSkeletalMesh(
+		SkeletalMesh,
+		LODsData,
+		SurfacesMaterial,
+		bNeedCPUAccess);
+}
+
+namespace
+{
+	/// Maps each bone of `SourceSkeleton` to the bone of `TargetSkeleton` with
+	/// the same name; the bones missing in `TargetSkeleton` are mapped to
+	/// their first ancestor that exists.
+	bool BuildBoneRemap(const FReferenceSkeleton& SourceSkeleton, const FReferenceSkeleton& TargetSkeleton, TArray<FBoneIndexType>& OutBoneRemap)
+	{
+		OutBoneRemap.SetNumUninitialized(SourceSkeleton.GetRawBoneNum());
+		for (int32 BoneIndex = 0; BoneIndex < SourceSkeleton.GetRawBoneNum(); BoneIndex += 1)
+		{
+			const int32 TargetBoneIndex = TargetSkeleton.FindRawBoneIndex(SourceSkeleton.GetBoneName(BoneIndex));
+			if (TargetBoneIndex != INDEX_NONE)
+			{
+				OutBoneRemap[BoneIndex] = TargetBoneIndex;
+				continue;
+			}
+
+			// The parents come first, so their bone is already mapped.
+			const int32 ParentIndex = SourceSkeleton.GetRawParentIndex(BoneIndex);
+			if (ParentIndex == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("The root bone %s isn't found in the target skeleton"), *SourceSkeleton.GetBoneName(BoneIndex).ToString());
+				return false;
+			}
+			OutBoneRemap[BoneIndex] = OutBoneRemap[ParentIndex];
+		}
+		return true;
+	}
+}
+
+bool FRuntimeSkeletalMeshGenerator::BuildMergedSkeletalMeshLODData(
+	const FReferenceSkeleton& RefSkeleton,
+	TConstArrayView<const USkeletalMesh*> SourceMeshes,
+	TArray<FRuntimeSkeletalMeshLODData>& OutLODs,
+	TArray<UMaterialInterface*>& OutSurfacesMaterial,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	check(IsInGameThread());
+	RUNTIME_SKELETAL_MESH_PHASE(MergeMeshes);
+
+	OutLODs.Reset();
+	OutSurfacesMaterial.Reset();
+
+	if (SourceMeshes.Num() == 0)
+	{
+		return false;
+	}
+
+	// Only the LODs all the sources have can be merged.
+	int32 LODsNum = MAX_int32;
+	for (const USkeletalMesh* SourceMesh : SourceMeshes)
+	{
+		const FSkeletalMeshRenderData* RenderData = SourceMesh ? SourceMesh->GetResourceForRendering() : nullptr;
+		if (RenderData == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("The meshes to merge must have the render data."));
+			return false;
+		}
+		LODsNum = FMath::Min(LODsNum, RenderData->LODRenderData.Num());
+	}
 
-	for (int WeightIdx = 0; WeightIdx < Weights.Num(); WeightIdx++)
+	TArray<TArray<FBoneIndexType>> BoneRemaps;
+	BoneRemaps.SetNum(SourceMeshes.Num());
+	TArray<int32> MaterialOffsets;
+	MaterialOffsets.SetNum(SourceMeshes.Num());
+	for (int32 SourceIndex = 0; SourceIndex < SourceMeshes.Num(); SourceIndex += 1)
 	{
-		for (int InfluenceIdx = 0; InfluenceIdx < MAX_TOTAL_INFLUENCES; ++InfluenceIdx)
+		if (!BuildBoneRemap(SourceMeshes[SourceIndex]->GetRefSkeleton(), RefSkeleton, BoneRemaps[SourceIndex]))
+		{
+			return false;
+		}
+
+		MaterialOffsets[SourceIndex] = OutSurfacesMaterial.Num();
+		for (const FSkeletalMaterial& Material : SourceMeshes[SourceIndex]->GetMaterials())
 		{
-			Weights[WeightIdx].InfluenceBones[InfluenceIdx] = 0;
-			Weights[WeightIdx].InfluenceWeights[InfluenceIdx] = 0;
+			OutSurfacesMaterial.Add(Material.MaterialInterface);
 		}
 	}
 
-	for (int32 SurfacesIndex = 0; SurfacesIndex < Surfaces.Num(); SurfacesIndex++)
+	OutLODs.SetNum(LODsNum);
+	for (int32 LODIndex = 0; LODIndex < LODsNum; LODIndex += 1)
 	{
-		const FMeshSurface& Surface = Surfaces[SurfacesIndex];
+		FRuntimeSkeletalMeshLODData& LODData = OutLODs[LODIndex];
+		LODData.bUseFullPrecisionUVs = BuildOptions.bUseFullPrecisionUVs;
+		LODData.bUseHighPrecisionTangentBasis = BuildOptions.bUseHighPrecisionTangentBasis;
+		LODData.bUseHighPrecisionBoneWeights = BuildOptions.bUseHighPrecisionBoneWeights;
+
+		// Each render section of the sources becomes a surface.
+		struct FSourceSection
+		{
+			int32 SourceIndex = 0;
+			int32 SectionIndex = 0;
+		};
+		TArray<FRuntimeSkeletalMeshView> Views;
+		Views.Reserve(SourceMeshes.Num());
+		TArray<FSourceSection> SourceSections;
+		uint32 VerticesNum = 0;
+		uint32 IndicesNum = 0;
+		int32 MaxSectionBones = 0;
+		for (int32 SourceIndex = 0; SourceIndex < SourceMeshes.Num(); SourceIndex += 1)
+		{
+			const FRuntimeSkeletalMeshView& View = Views.Emplace_GetRef(SourceMeshes[SourceIndex], LODIndex);
+			if (!View.IsValid())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("The mesh %s doesn't keep its vertices on the CPU, enable `bAllowCPUAccess`."), *SourceMeshes[SourceIndex]->GetName());
+				OutLODs.Reset();
+				return false;
+			}
+
+			LODData.UVCount = FMath::Max<int32>(LODData.UVCount, View.NumTexCoords());
+			LODData.MaxBoneInfluences = FMath::Max<int32>(LODData.MaxBoneInfluences, View.NumBoneInfluences());
+			LODData.bHasVertexColors |= View.HasColors();
 
-		for (int32 LocalVertexIndex = 0; LocalVertexIndex < Surface.BoneInfluences.Num(); LocalVertexIndex += 1)
+			for (int32 SectionIndex = 0; SectionIndex < View.GetSections().Num(); SectionIndex += 1)
+			{
+				const FSkelMeshRenderSection& RenderSection = View.GetSections()[SectionIndex];
+				SourceSections.Add({SourceIndex, SectionIndex});
+				LODData.SurfaceVertexOffsets.Add(VerticesNum);
+				LODData.SurfaceIndexOffsets.Add(IndicesNum);
+				VerticesNum += RenderSection.NumVertices;
+				IndicesNum += RenderSection.NumTriangles * 3;
+				MaxSectionBones = FMath::Max(MaxSectionBones, RenderSection.BoneMap.Num());
+			}
+		}
+		LODData.bUseFullPrecisionUVs = LODData.bUseFullPrecisionUVs || LODData.UVCount == 0;
+		LODData.bUse16BitBoneIndex = MaxSectionBones > MAX_uint8 + 1;
+
+		const uint32 TangentsStride = GetTangentsStride(LODData);
+		const uint32 TexCoordsStride = GetTexCoordsStride(LODData);
+		const uint32 TexCoordSize = LODData.bUseFullPrecisionUVs ? sizeof(FVector2f) : sizeof(FVector2DHalf);
+		const uint32 SkinWeightsStride = GetSkinWeightsStride(LODData);
+		const uint32 BoneIndexSize = LODData.bUse16BitBoneIndex ? sizeof(uint16) : sizeof(uint8);
+		const uint32 BoneWeightSize = LODData.bUseHighPrecisionBoneWeights ? sizeof(uint16) : sizeof(uint8);
+
+		FRuntimeSkeletalMeshVertexStreams& Streams = LODData.VertexStreams;
+		Streams.Positions.SetNumUninitialized(VerticesNum);
+		Streams.Tangents.SetNumUninitialized(VerticesNum * TangentsStride);
+		Streams.TexCoords.SetNumUninitialized(VerticesNum * TexCoordsStride);
+		Streams.Colors.SetNumUninitialized(LODData.bHasVertexColors ? VerticesNum : 0);
+		Streams.SkinWeights.SetNumUninitialized(VerticesNum * SkinWeightsStride);
+		LODData.Indices.SetNumUninitialized(IndicesNum);
+		LODData.Sections.SetNum(SourceSections.Num());
+
+		TArray<FBox3f> SectionsBounds;
+		SectionsBounds.Init(FBox3f(ForceInit), SourceSections.Num());
+		ParallelFor(SourceSections.Num(), [&](const int32 SurfaceIndex)
 		{
-			const TArray<FRawBoneInfluence>& VertInfluences = Surface.BoneInfluences[LocalVertexIndex];
-			const int32 VertexIndex = SurfaceVertexOffsets[SurfacesIndex] + LocalVertexIndex;
-			FSkinWeightInfo& Weight = Weights[VertexIndex];
+			const FSourceSection& SourceSection = SourceSections[SurfaceIndex];
+			const FRuntimeSkeletalMeshView& View = Views[SourceSection.SourceIndex];
+			const FSkelMeshRenderSection& RenderSection = View.GetSections()[SourceSection.SectionIndex];
+			const uint32 VertexOffset = LODData.SurfaceVertexOffsets[SurfaceIndex];
+			const uint32 NumVertices = RenderSection.NumVertices;
+
+			// The streams already in the target format are copied as they are,
+			// the others are converted vertex by vertex.
+			const TConstArrayView<FVector3f> Positions = View.GetSectionPositions(SourceSection.SectionIndex);
+			FMemory::Memcpy(Streams.Positions.GetData() + VertexOffset, Positions.GetData(), Positions.Num() * sizeof(FVector3f));
+			for (const FVector3f& Position : Positions)
+			{
+				SectionsBounds[SurfaceIndex] += Position;
+			}
 
-			for (int InfluenceIndex = 0; InfluenceIndex < MaxBoneInfluences; InfluenceIndex++)
+			uint8* Tangents = Streams.Tangents.GetData() + VertexOffset * TangentsStride;
+			if (View.HasHighPrecisionTangents() == LODData.bUseHighPrecisionTangentBasis)
+			{
+				const TConstArrayView<uint8> SourceTangents = View.GetSectionTangentData(SourceSection.SectionIndex);
+				FMemory::Memcpy(Tangents, SourceTangents.GetData(), SourceTangents.Num());
+			}
+			else
 			{
-				if (InfluenceIndex >= VertInfluences.Num())
+				for (uint32 I = 0; I < NumVertices; I += 1)
 				{
-					// The available influences for this surface, is smaller than the whole
-					// Mesh. This happens when the user submits surfaces with different
-					// bone weights. Pad it automatically, to simplify the user life.
-					Weight.InfluenceWeights[InfluenceIndex] = 0;
-					Weight.InfluenceBones[InfluenceIndex] = 0;
+					const uint32 SourceVertexIndex = RenderSection.BaseVertexIndex + I;
+					EncodeTangents(
+						View.DecodeTangent(SourceVertexIndex, 0),
+						View.DecodeTangent(SourceVertexIndex, 1),
+						LODData.bUseHighPrecisionTangentBasis,
+						Tangents + I * TangentsStride);
 				}
-				else
-				{
-					const FRawBoneInfluence& VertInfluence = VertInfluences[InfluenceIndex];
-					// Make sure these are the same.
-					check(LocalVertexIndex == VertInfluence.VertexIndex);
+			}
 
-					if (!SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().IsValidIndex(VertInfluence.BoneIndex))
+			uint8* TexCoords = Streams.TexCoords.GetData() + VertexOffset * TexCoordsStride;
+			if (View.NumTexCoords() == uint32(LODData.UVCount) && View.HasFullPrecisionUVs() == LODData.bUseFullPrecisionUVs)
+			{
+				const TConstArrayView<uint8> SourceTexCoords = View.GetSectionTexCoordData(SourceSection.SectionIndex);
+				FMemory::Memcpy(TexCoords, SourceTexCoords.GetData(), SourceTexCoords.Num());
+			}
+			else
+			{
+				// The missing UV channels are zero.
+				for (uint32 I = 0; I < NumVertices; I += 1)
+				{
+					const uint32 SourceVertexIndex = RenderSection.BaseVertexIndex + I;
+					for (int32 UVIndex = 0; UVIndex < LODData.UVCount; UVIndex += 1)
 					{
-						// This bone appear to be invalid, continue.
-						UE_LOG(LogTemp, Warning, TEXT("The bone %i isn't found in this skeleton"), VertInfluence.BoneIndex);
-						continue;
+						EncodeTexCoord(
+							uint32(UVIndex) < View.NumTexCoords() ? View.GetUV(SourceVertexIndex, UVIndex) : FVector2f::ZeroVector,
+							LODData.bUseFullPrecisionUVs,
+							TexCoords + I * TexCoordsStride + UVIndex * TexCoordSize);
 					}
+				}
+			}
 
-					// Convert 0.0 - 1.0 range to 0 - 65535
-					const uint16 EncodedWeight = FMath::Clamp(VertInfluence.Weight, 0., 1.) * 65535;
-					Weight.InfluenceWeights[InfluenceIndex] = EncodedWeight;
-					Weight.InfluenceBones[InfluenceIndex] = EncodedWeight == 0 ? 0 : VertInfluence.BoneIndex;
-
-#if WITH_EDITORONLY_DATA
-					if (Weight.InfluenceBones[InfluenceIndex] != INDEX_NONE)
+			if (LODData.bHasVertexColors)
+			{
+				const TConstArrayView<FColor> Colors = View.GetSectionColors(SourceSection.SectionIndex);
+				if (Colors.Num() > 0)
+				{
+					FMemory::Memcpy(Streams.Colors.GetData() + VertexOffset, Colors.GetData(), Colors.Num() * sizeof(FColor));
+				}
+				else
+				{
+					for (uint32 I = 0; I < NumVertices; I += 1)
 					{
-						SkeletalMeshImportData::FRawBoneInfluence& Influence = ImportedModelData.Influences.AddDefaulted_GetRef();
-						Influence.Weight = static_cast<float>(FMath::Clamp(Weight.InfluenceWeights[InfluenceIndex] / 65535.0, 0.0, 1.0));
-						Influence.BoneIndex = Weight.InfluenceBones[InfluenceIndex];
-						Influence.VertexIndex = VertexIndex;
+						Streams.Colors[VertexOffset + I] = FColor::White;
 					}
-#endif
 				}
-				
 			}
-			
-		}
-	}
-
-	// Enables all the Bones of this skeleton, to avoid break the mesh.
-#if WITH_EDITOR
-	SkeletalMeshLODModel->ActiveBoneIndices.Empty();
-	SkeletalMeshLODModel->RequiredBones.Empty();
-#endif
-	LODMeshRenderData->RequiredBones.Empty();
-	LODMeshRenderData->ActiveBoneIndices.Empty();
 
-	for (int32 I = 0; I < Surfaces.Num(); I++)
-	{
-		FSkelMeshRenderSection& RenderSection = LODMeshRenderData->RenderSections[I];
-		RenderSection.BoneMap.Empty();
-#if WITH_EDITOR
-		FSkelMeshSection& MeshSection = SkeletalMeshLODModel->Sections[I];
-		MeshSection.BoneMap.Empty();
-#endif
-	}
+			// The weights keep the section bone index: only the `BoneMap` changes.
+			uint8* SkinWeights = Streams.SkinWeights.GetData() + VertexOffset * SkinWeightsStride;
+			if (View.NumBoneInfluences() == uint32(LODData.MaxBoneInfluences)
+				&& View.GetBoneIndexSize() == BoneIndexSize
+				&& View.GetBoneWeightSize() == BoneWeightSize)
+			{
+				const TConstArrayView<uint8> SourceWeights = View.GetSectionWeightData(SourceSection.SectionIndex);
+				FMemory::Memcpy(SkinWeights, SourceWeights.GetData(), SourceWeights.Num());
+			}
+			else
+			{
+				const bool bQuantize = !LODData.bUseHighPrecisionBoneWeights && View.GetBoneWeightSize() != sizeof(uint8);
+				for (uint32 I = 0; I < NumVertices; I += 1)
+				{
+					const uint32 SourceVertexIndex = RenderSection.BaseVertexIndex + I;
+					FSkinWeightInfo Weight;
+					FMemory::Memzero(Weight);
+					for (uint32 InfluenceIndex = 0; InfluenceIndex < View.NumBoneInfluences(); InfluenceIndex += 1)
+					{
+						Weight.InfluenceBones[InfluenceIndex] = View.GetBoneIndex(SourceVertexIndex, InfluenceIndex);
+						Weight.InfluenceWeights[InfluenceIndex] = View.GetBoneWeight(SourceVertexIndex, InfluenceIndex);
+					}
+					if (bQuantize)
+					{
+						QuantizeBoneWeightsTo8Bit(Weight);
+					}
+					EncodeSkinWeight(
+						Weight,
+						LODData.MaxBoneInfluences,
+						LODData.bUse16BitBoneIndex,
+						LODData.bUseHighPrecisionBoneWeights,
+						SkinWeights + I * SkinWeightsStride);
+				}
+			}
 
-	const int32 BoneNum = SkeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawBoneNum();
-	for (int32 BoneIndex = 0; BoneIndex < BoneNum; BoneIndex++)
-	{
-#if WITH_EDITOR
-		SkeletalMeshLODModel->ActiveBoneIndices.AddUnique(BoneIndex);
-		SkeletalMeshLODModel->RequiredBones.AddUnique(BoneIndex);
-#endif
-		LODMeshRenderData->RequiredBones.AddUnique(BoneIndex);
-		LODMeshRenderData->ActiveBoneIndices.AddUnique(BoneIndex);
+			// Copy the indices, rebased on the merged vertex buffer: the unsigned
+			// subtraction wraps, so the offset can be negative.
+			const uint32 IndexOffset = LODData.SurfaceIndexOffsets[SurfaceIndex];
+			View.CopyIndices(
+				RenderSection.BaseIndex,
+				TArrayView<uint32>(LODData.Indices.GetData() + IndexOffset, RenderSection.NumTriangles * 3),
+				RenderSection.BaseVertexIndex - VertexOffset);
+
+			FRuntimeSkeletalMeshSection& Section = LODData.Sections[SurfaceIndex];
+			Section.SurfaceIndex = SurfaceIndex;
+			Section.MaterialIndex = MaterialOffsets[SourceSection.SourceIndex] + RenderSection.MaterialIndex;
+			Section.BaseVertexIndex = VertexOffset;
+			Section.NumVertices = NumVertices;
+			Section.BaseIndex = IndexOffset;
+			Section.NumTriangles = RenderSection.NumTriangles;
+			Section.MaxBoneInfluences = RenderSection.MaxBoneInfluences;
+			Section.BoneMap.SetNumUninitialized(RenderSection.BoneMap.Num());
+			for (int32 I = 0; I < RenderSection.BoneMap.Num(); I += 1)
+			{
+				Section.BoneMap[I] = BoneRemaps[SourceSection.SourceIndex][RenderSection.BoneMap[I]];
+			}
+		});
 
-		for (int32 I = 0; I < Surfaces.Num(); I++)
+		for (const FBox3f& SectionBounds : SectionsBounds)
 		{
-			FSkelMeshRenderSection& RenderSection = LODMeshRenderData->RenderSections[I];
-			RenderSection.BoneMap.AddUnique(BoneIndex);
-#if WITH_EDITOR
-			FSkelMeshSection& MeshSection = SkeletalMeshLODModel->Sections[I];
-			MeshSection.BoneMap.AddUnique(BoneIndex);
-#endif
+			LODData.Bounds += FBox(SectionBounds);
 		}
-	}
 
-	// Set the skin weights.
-	LODMeshRenderData->SkinWeightVertexBuffer.SetNeedsCPUAccess(bNeedCPUAccess);
-	LODMeshRenderData->SkinWeightVertexBuffer = Weights;
+		// The sources may disagree on when to switch LOD: the first one decides.
+		const FSkeletalMeshLODInfo* LODInfo = SourceMeshes[0]->GetLODInfo(LODIndex);
+		if (LODInfo != nullptr)
+		{
+			LODData.ScreenSize = LODInfo->ScreenSize.Default;
+			LODData.LODHysteresis = LODInfo->LODHysteresis;
+		}
 
-	// Set the default Material.
-	SkeletalMesh->GetMaterials().Reserve(SurfacesMaterial.Num());
-	for (auto& Material : SurfacesMaterial)
-	{
-		SkeletalMesh->GetMaterials().Emplace(Material);
+#if WITH_EDITORONLY_DATA
+		DecodeVertexStreams(LODData);
+		BuildImportedModelData(RefSkeleton, OutSurfacesMaterial, TMap<FName, FTransform>(), LODData);
+#endif
 	}
 
-	// Rebuild inverse ref pose matrices.
-	SkeletalMesh->GetRefBasesInvMatrix().Empty();
-	SkeletalMesh->CalculateInvRefMatrices(); 
-	MeshRenderData->bReadyForStreaming = false;
-
-	// Suspected Finalization step
-	if (!GIsEditor)
-	{
-		SkeletalMesh->NeverStream = false;
-	}
-	if(bNeedCPUAccess)
-	{
-		SkeletalMesh->NeverStream = true;
-	}
+	return true;
+}
 
-#if WITH_EDITOR
-	if (SkeletalMesh->GetLODSettings() != nullptr)
+bool FRuntimeSkeletalMeshGenerator::MergeSkeletalMeshes(
+	USkeletalMesh* SkeletalMesh,
+	TConstArrayView<const USkeletalMesh*> SourceMeshes,
+	const bool bNeedCPUAccess,
+	const FRuntimeSkeletalMeshBuildOptions& BuildOptions)
+{
+	TArray<FRuntimeSkeletalMeshLODData> LODsData;
+	TArray<UMaterialInterface*> SurfacesMaterial;
+	if (!BuildMergedSkeletalMeshLODData(
+		SkeletalMesh->GetSkeleton()->GetReferenceSkeleton(),
+		SourceMeshes,
+		LODsData,
+		SurfacesMaterial,
+		BuildOptions))
 	{
-		// update mapping information on the class
-		SkeletalMesh->GetLODSettings()->SetLODSettingsFromMesh(SkeletalMesh);
-
-		checkf(SkeletalMesh->GetLODSettings() != nullptr, TEXT("At this point the LODSetings are supposed to be set."));
-
-		const int32 NumSettings = FMath::Min(SkeletalMesh->GetLODSettings()->GetNumberOfSettings(), SkeletalMesh->GetLODNum());
-		checkf(LODIndex < NumSettings, TEXT("Make sure the LODSettings are set for the LODIndex 0."));
-
-		const FSkeletalMeshLODGroupSettings* SkeletalMeshLODGroupSettings = &SkeletalMesh->GetLODSettings()->GetSettingsForLODLevel(LODIndex);
-		MeshLodInfo.BuildGUID = MeshLodInfo.ComputeDeriveDataCacheKey(SkeletalMeshLODGroupSettings);
+		return false;
 	}
 
-	const FString BuildStringID = SkeletalMesh->GetImportedModel()->LODModels[0].GetLODModelDeriveDataKey();
-	SkeletalMesh->GetImportedModel()->LODModels[0].BuildStringID = BuildStringID;
-
-	SkeletalMesh->SetLODImportedDataVersions(0, ESkeletalMeshGeoImportVersions::LatestVersion, ESkeletalMeshSkinningImportVersions::LatestVersion);
-	SkeletalMesh->SaveLODImportedData(0, ImportedModelData);
-	SkeletalMesh->InvalidateDeriveDataCacheGUID();
-#endif
+	return CommitSkeletalMesh(
+		SkeletalMesh,
+		LODsData,
+		SurfacesMaterial,
+		bNeedCPUAccess);
+}
 
-	// Calls InitResources.
-	SkeletalMesh->PostLoad();
+FRuntimeSkeletalMeshGeneratorStats FRuntimeSkeletalMeshGenerator::GetStats()
+{
+	FRuntimeSkeletalMeshGeneratorStats Stats;
+	Stats.BuiltLODs = GeneratorStats.BuiltLODs;
+	Stats.CommittedMeshes = GeneratorStats.CommittedMeshes;
+	Stats.DecomposedMeshes = GeneratorStats.DecomposedMeshes;
+
+	Stats.CountSeconds = FPlatformTime::ToSeconds64(GeneratorStats.CountCycles);
+	Stats.PackSeconds = FPlatformTime::ToSeconds64(GeneratorStats.PackCycles);
+	Stats.IndicesSeconds = FPlatformTime::ToSeconds64(GeneratorStats.IndicesCycles);
+	Stats.BoneMapSeconds = FPlatformTime::ToSeconds64(GeneratorStats.BoneMapCycles);
+	Stats.OptimizeSeconds = FPlatformTime::ToSeconds64(GeneratorStats.OptimizeCycles);
+	Stats.WeldSeconds = FPlatformTime::ToSeconds64(GeneratorStats.WeldCycles);
+	Stats.DuplicatedVerticesSeconds = FPlatformTime::ToSeconds64(GeneratorStats.DuplicatedVerticesCycles);
+	Stats.MergeSeconds = FPlatformTime::ToSeconds64(GeneratorStats.MergeCycles);
+	Stats.MergeMeshesSeconds = FPlatformTime::ToSeconds64(GeneratorStats.MergeMeshesCycles);
+	Stats.ImportDataSeconds = FPlatformTime::ToSeconds64(GeneratorStats.ImportDataCycles);
+	Stats.IndexBufferSeconds = FPlatformTime::ToSeconds64(GeneratorStats.IndexBufferCycles);
+	Stats.VertexBuffersSeconds = FPlatformTime::ToSeconds64(GeneratorStats.VertexBuffersCycles);
+	Stats.SkinWeightsSeconds = FPlatformTime::ToSeconds64(GeneratorStats.SkinWeightsCycles);
+	Stats.PostLoadSeconds = FPlatformTime::ToSeconds64(GeneratorStats.PostLoadCycles);
+	Stats.DecomposeSeconds = FPlatformTime::ToSeconds64(GeneratorStats.DecomposeCycles);
+
+	Stats.Vertices = GeneratorStats.Vertices;
+	Stats.Indices = GeneratorStats.Indices;
+	Stats.Sections = GeneratorStats.Sections;
+	Stats.SectionBones = GeneratorStats.SectionBones;
+	Stats.AllocatedBytes = GeneratorStats.AllocatedBytes;
+	return Stats;
+}
 
-#if WITH_EDITOR
-	// Signals to editor we are done with our changes
-	// This is to prevent the editor variable changes overwriting the import mesh,
-	// if you don't set this random crashes occur.
-	SkeletalMesh->StackPostEditChange();
-#endif
-	return true;
+void FRuntimeSkeletalMeshGenerator::ResetStats()
+{
+	GeneratorStats.BuiltLODs = 0;
+	GeneratorStats.CommittedMeshes = 0;
+	GeneratorStats.DecomposedMeshes = 0;
+
+	GeneratorStats.CountCycles = 0;
+	GeneratorStats.PackCycles = 0;
+	GeneratorStats.IndicesCycles = 0;
+	GeneratorStats.BoneMapCycles = 0;
+	GeneratorStats.OptimizeCycles = 0;
+	GeneratorStats.WeldCycles = 0;
+	GeneratorStats.DuplicatedVerticesCycles = 0;
+	GeneratorStats.MergeCycles = 0;
+	GeneratorStats.MergeMeshesCycles = 0;
+	GeneratorStats.ImportDataCycles = 0;
+	GeneratorStats.IndexBufferCycles = 0;
+	GeneratorStats.VertexBuffersCycles = 0;
+	GeneratorStats.SkinWeightsCycles = 0;
+	GeneratorStats.PostLoadCycles = 0;
+	GeneratorStats.DecomposeCycles = 0;
+
+	GeneratorStats.Vertices = 0;
+	GeneratorStats.Indices = 0;
+	GeneratorStats.Sections = 0;
+	GeneratorStats.SectionBones = 0;
+	GeneratorStats.AllocatedBytes = 0;
 }
 
 USkeletalMeshComponent* FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshComponent(
@@ -612,34 +4070,56 @@ USkeletalMeshComponent* FRuntimeSkeletalMeshGenerator::GenerateSkeletalMeshCompo
 	const TArray<FMeshSurface>& Surfaces,
 	const TArray<UMaterialInterface*>& SurfacesMaterial,
 	const bool bNeedCPUAccess,
-	const TMap<FName, FTransform>& BoneTransformsOverride)
+	const TMap<FName, FTransform>& BoneTransformsOverride,
+	FRuntimeSkeletalMeshCache* Cache,
+	FRuntimeSkeletalMeshPool* Pool)
 {
-	// Note: we do not pass anything so the skeletal mesh is transient and
-	// destroyed when the play session end.
 	if(!BaseSkeleton)
 		return nullptr;
 
-	const TObjectPtr<USkeletalMesh> SkeletalMesh = NewObject<USkeletalMesh>();
-	if(!SkeletalMesh)
-		return nullptr;
-	SkeletalMesh->SetRefSkeleton(BaseSkeleton->GetReferenceSkeleton());
-	SkeletalMesh->SetSkeleton(BaseSkeleton);
-
-
-	if(!GenerateSkeletalMesh(
-		SkeletalMesh,
-		Surfaces,
-		SurfacesMaterial,
-		bNeedCPUAccess,
-		BoneTransformsOverride))
+	TObjectPtr<USkeletalMesh> SkeletalMesh;
+	if (Cache)
 	{
-		return nullptr;
+		SkeletalMesh = Cache->FindOrGenerate(
+			BaseSkeleton,
+			Surfaces,
+			SurfacesMaterial,
+			bNeedCPUAccess,
+			BoneTransformsOverride);
+		if(!SkeletalMesh)
+			return nullptr;
+	}
+	else
+	{
+		// Note: we do not pass anything so the skeletal mesh is transient and
+		// destroyed when the play session end.
+		SkeletalMesh = Pool ? Pool->AcquireSkeletalMesh() : NewObject<USkeletalMesh>();
+		if(!SkeletalMesh)
+			return nullptr;
+		SkeletalMesh->SetRefSkeleton(BaseSkeleton->GetReferenceSkeleton());
+		SkeletalMesh->SetSkeleton(BaseSkeleton);
+
+		if(!GenerateSkeletalMesh(
+			SkeletalMesh,
+			Surfaces,
+			SurfacesMaterial,
+			bNeedCPUAccess,
+			BoneTransformsOverride))
+		{
+			if (Pool)
+			{
+				Pool->ReleaseSkeletalMesh(SkeletalMesh);
+			}
+			return nullptr;
+		}
 	}
 
 	const TObjectPtr<USkeletalMeshComponent> SkeletalMeshComponent =
-		NewObject<USkeletalMeshComponent>(
-			Actor,
-			USkeletalMeshComponent::StaticClass());
+		Pool
+			? Pool->AcquireComponent(Actor)
+			: NewObject<USkeletalMeshComponent>(
+				Actor,
+				USkeletalMeshComponent::StaticClass());
 	if(!SkeletalMeshComponent)
 		return nullptr;
 
@@ -677,31 +4157,62 @@ bool FRuntimeSkeletalMeshGenerator::UpdateSkeletalMeshComponent(
 	const TArray<FMeshSurface>& Surfaces,
 	const TArray<UMaterialInterface*>& SurfacesMaterial,
 	const bool bNeedCPUAccess,
-	const TMap<FName, FTransform>& BoneTransformOverrides)
+	const TMap<FName, FTransform>& BoneTransformOverrides,
+	FRuntimeSkeletalMeshCache* Cache,
+	FRuntimeSkeletalMeshPool* Pool)
 {
-	// Note: we do not pass anything so the skeletal mesh is transient and
-	// destroyed when the play session end.
 	if (!SkeletalMeshComponent || !BaseSkeleton)
 		return false;
 
-	const TObjectPtr<USkeletalMesh> SkeletalMesh = NewObject<USkeletalMesh>();
-	if(!SkeletalMesh)
-		return false;
-	SkeletalMesh->SetRefSkeleton(BaseSkeleton->GetReferenceSkeleton());
-	SkeletalMesh->SetSkeleton(BaseSkeleton);
+	TObjectPtr<USkeletalMesh> SkeletalMesh;
+	if (Cache)
+	{
+		SkeletalMesh = Cache->FindOrGenerate(
+			BaseSkeleton,
+			Surfaces,
+			SurfacesMaterial,
+			bNeedCPUAccess,
+			BoneTransformOverrides);
+		if(!SkeletalMesh)
+			return false;
+	}
+	else
+	{
+		// Note: we do not pass anything so the skeletal mesh is transient and
+		// destroyed when the play session end.
+		SkeletalMesh = Pool ? Pool->AcquireSkeletalMesh() : NewObject<USkeletalMesh>();
+		if(!SkeletalMesh)
+			return false;
+		SkeletalMesh->SetRefSkeleton(BaseSkeleton->GetReferenceSkeleton());
+		SkeletalMesh->SetSkeleton(BaseSkeleton);
+
+		if(!GenerateSkeletalMesh(
+			SkeletalMesh.Get(),
+			Surfaces,
+			SurfacesMaterial,
+			bNeedCPUAccess,
+			BoneTransformOverrides))
+		{
+			if (Pool)
+			{
+				Pool->ReleaseSkeletalMesh(SkeletalMesh);
+			}
+			return false;
+		}
+	}
 
-	if(!GenerateSkeletalMesh(
-		SkeletalMesh.Get(),
-		Surfaces,
-		SurfacesMaterial,
-		bNeedCPUAccess,
-		BoneTransformOverrides))
-		return false;
+	USkeletalMesh* PreviousSkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset();
 
 	// We register the skeleton resource (which is not meant to be transient to
 	// the engine).
 	SkeletalMeshComponent->SetSkeletalMesh(SkeletalMesh);
 
+	if (Pool && PreviousSkeletalMesh != SkeletalMesh)
+	{
+		// Does nothing when the previous mesh doesn't come from the pool.
+		Pool->ReleaseSkeletalMesh(PreviousSkeletalMesh);
+	}
+
 	if (bNeedCPUAccess)
 	{
 		SkeletalMeshComponent->SetCPUSkinningEnabled(true);
@@ -726,107 +4237,284 @@ bool FRuntimeSkeletalMeshGenerator::DecomposeSkeletalMesh(
 	TArray<UMaterialInterface*>& OutSurfacesMaterial)
 {
 	OutSurfaces.Empty();
-	OutSurfacesVertexOffsets.Empty();
-	OutSurfacesIndexOffsets.Empty();
-	OutSurfacesMaterial.Empty();
 
-	// Assume only the LOD 0 exist.
-	constexpr int32 LODIndex = 0;
-
-	// Extract the Surfaces from the `SourceMesh`
-	const int32 RenderSectionsNum = SkeletalMesh->GetResourceForRendering()->LODRenderData[LODIndex].RenderSections.Num();;
-
-	OutSurfaces.SetNum(RenderSectionsNum);
-	OutSurfacesVertexOffsets.SetNum(RenderSectionsNum);
-	OutSurfacesIndexOffsets.SetNum(RenderSectionsNum);
+	TArray<FPackedMeshSurface> PackedSurfaces;
+	if (!DecomposeSkeletalMesh(
+		SkeletalMesh,
+		PackedSurfaces,
+		OutSurfacesVertexOffsets,
+		OutSurfacesIndexOffsets,
+		OutSurfacesMaterial))
+	{
+		return false;
+	}
 
-	const FSkeletalMeshLODRenderData& RenderData = SkeletalMesh->GetResourceForRendering()->LODRenderData[LODIndex];
+	OutSurfaces.SetNum(PackedSurfaces.Num());
+	for (int32 SurfaceIndex = 0; SurfaceIndex < PackedSurfaces.Num(); SurfaceIndex += 1)
+	{
+		PackedSurfaces[SurfaceIndex].ToMeshSurface(OutSurfaces[SurfaceIndex]);
+	}
 
-	TArray<uint32> IndexBuffer;
-	RenderData.MultiSizeIndexContainer.GetIndexBuffer(IndexBuffer);
+	return true;
+}
 
-	for (int32 SectionIndex = 0; SectionIndex < RenderSectionsNum; SectionIndex += 1)
+namespace
+{
+	/// Extracts the `Sections` of the LOD seen by `View` in `OutSurfaces`. The
+	/// surfaces are allocated first, then the vertices and the indices are read
+	/// in parallel, in ranges of at most `ElementsPerTask` elements.
+	bool DecomposeLOD(
+		const FRuntimeSkeletalMeshView& View,
+		TConstArrayView<int32> Sections,
+		TArray<FPackedMeshSurface>& OutSurfaces,
+		TArray<int32>& OutSurfacesVertexOffsets,
+		TArray<int32>& OutSurfacesIndexOffsets)
 	{
-		FMeshSurface& Surface = OutSurfaces[SectionIndex];
+		OutSurfaces.Empty();
+		OutSurfacesVertexOffsets.Empty();
+		OutSurfacesIndexOffsets.Empty();
 
-		const FSkelMeshRenderSection& RenderSection = RenderData.RenderSections[SectionIndex];
+		if (!View.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("The mesh buffers are not available on the CPU, set `bAllowCPUAccess` to decompose it."));
+			return false;
+		}
 
-		const uint32 VertexIndexOffset = RenderSection.BaseVertexIndex;
-		const uint32 VertexNum = RenderSection.NumVertices;
+		const TConstArrayView<FSkelMeshRenderSection> RenderSections = View.GetSections();
+		for (const int32 SectionIndex : Sections)
+		{
+			if (!RenderSections.IsValidIndex(SectionIndex))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("The section %i doesn't exist in this LOD."), SectionIndex);
+				return false;
+			}
+		}
 
-		OutSurfacesVertexOffsets[SectionIndex] = VertexIndexOffset;
+		const int32 SurfacesNum = Sections.Num();
+		const int32 UVChannels = View.NumTexCoords();
 
-		Surface.Vertices.SetNum(VertexNum);
-		Surface.Normals.SetNum(VertexNum);
-		Surface.Tangents.SetNum(VertexNum);
-		Surface.FlipBinormalSigns.SetNum(VertexNum);
-		Surface.Uvs.SetNum(VertexNum);
-		Surface.Colors.SetNum(VertexNum);
-		Surface.BoneInfluences.SetNum(VertexNum);
+		OutSurfaces.SetNum(SurfacesNum);
+		OutSurfacesVertexOffsets.SetNum(SurfacesNum);
+		OutSurfacesIndexOffsets.SetNum(SurfacesNum);
 
-		for (uint32 i = 0; i < VertexNum; i += 1)
+		for (int32 SurfaceIndex = 0; SurfaceIndex < SurfacesNum; SurfaceIndex += 1)
 		{
-			const uint32 VertexIndex = VertexIndexOffset + i;
+			FPackedMeshSurface& Surface = OutSurfaces[SurfaceIndex];
+			const FSkelMeshRenderSection& RenderSection = RenderSections[Sections[SurfaceIndex]];
+			const int32 VertexNum = RenderSection.NumVertices;
+
+			checkf(static_cast<int32>(View.NumBoneInfluences()) >= RenderSection.MaxBoneInfluences, TEXT("These two MUST be the same."));
+
+			OutSurfacesVertexOffsets[SurfaceIndex] = RenderSection.BaseVertexIndex;
+			OutSurfacesIndexOffsets[SurfaceIndex] = RenderSection.BaseIndex;
+
+			Surface.MaterialIndex = RenderSection.MaterialIndex;
+			Surface.UVChannels = UVChannels;
+			Surface.InfluenceSlots = RenderSection.MaxBoneInfluences;
+			Surface.Indices.SetNumUninitialized(RenderSection.NumTriangles * 3);
+			Surface.Vertices.SetNumUninitialized(VertexNum);
+			Surface.Normals.SetNumUninitialized(VertexNum);
+			Surface.Tangents.SetNumUninitialized(VertexNum);
+			Surface.FlipBinormalSigns.SetNumUninitialized(VertexNum);
+			Surface.Uvs.SetNumUninitialized(VertexNum * UVChannels);
+			// Not all meshes have vertex colors: those without are left to 0.
+			Surface.Colors.SetNumZeroed(VertexNum);
+			Surface.InfluenceBones.SetNumUninitialized(VertexNum * Surface.InfluenceSlots);
+			Surface.InfluenceWeights.SetNumUninitialized(VertexNum * Surface.InfluenceSlots);
+		}
 
-			Surface.Vertices[i] = FVector(RenderData.StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex));
+		const TArray<FSurfaceTaskRange> VertexTasks = MakeSurfaceTaskRanges(
+			SurfacesNum,
+			[&](const int32 SurfaceIndex) { return OutSurfaces[SurfaceIndex].Vertices.Num(); });
 
-			Surface.Normals[i] = FVector(RenderData.StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex));
-			Surface.Tangents[i] = FVector(RenderData.StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex));
-			// Check if the Binormal Sign is flipped.
-			const FVector& ActualBinormal = FVector(RenderData.StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex));
-			const FVector CalculatedBinormal = FVector::CrossProduct(Surface.Normals[i], Surface.Tangents[i]);
-			// If the Binormal points toward different location, the `FlipBinormalSign`
-			// must be `false`. Check how the `VertexTangentY` is computed above.
-			Surface.FlipBinormalSigns[i] = FVector::DotProduct(ActualBinormal, CalculatedBinormal) < 0.99;
+		ParallelFor(VertexTasks.Num(), [&](const int32 TaskIndex)
+		{
+			const FSurfaceTaskRange& Task = VertexTasks[TaskIndex];
+			FPackedMeshSurface& Surface = OutSurfaces[Task.SurfaceIndex];
+			const FSkelMeshRenderSection& RenderSection = RenderSections[Sections[Task.SurfaceIndex]];
 
-			Surface.Uvs[i].SetNum(RenderData.StaticVertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords());
-			for (uint32 UVIndex = 0; UVIndex < RenderData.StaticVertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords(); UVIndex += 1)
+			for (int32 I = Task.Begin; I < Task.End; I += 1)
 			{
-				Surface.Uvs[i][UVIndex] = FVector2d(RenderData.StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex, UVIndex));
-			}
+				const uint32 VertexIndex = RenderSection.BaseVertexIndex + I;
 
-			if (VertexIndex < RenderData.StaticVertexBuffers.ColorVertexBuffer.GetNumVertices())
-			{
-				// Make sure the color is set. Not all meshes have vertex colors.
-				Surface.Colors[i] = RenderData.StaticVertexBuffers.ColorVertexBuffer.VertexColor(VertexIndex);
+				Surface.Vertices[I] = View.GetPosition(VertexIndex);
+				Surface.Normals[I] = View.GetTangentZ(VertexIndex);
+				Surface.Tangents[I] = View.GetTangentX(VertexIndex);
+				// If the Binormal points toward different location, the `FlipBinormalSign`
+				// must be `false`. Check how the `TangentY` is computed by the view.
+				const FVector3f CalculatedBinormal = FVector3f::CrossProduct(Surface.Normals[I], Surface.Tangents[I]);
+				Surface.FlipBinormalSigns[I] = FVector3f::DotProduct(View.GetTangentY(VertexIndex), CalculatedBinormal) < 0.99f;
+
+				for (int32 UVIndex = 0; UVIndex < UVChannels; UVIndex += 1)
+				{
+					Surface.Uvs[I * UVChannels + UVIndex] = View.GetUV(VertexIndex, UVIndex);
+				}
+
+				if (View.HasColors())
+				{
+					Surface.Colors[I] = View.GetColor(VertexIndex);
+				}
+
+				for (int32 InfluenceIndex = 0; InfluenceIndex < Surface.InfluenceSlots; InfluenceIndex += 1)
+				{
+					const int32 Slot = I * Surface.InfluenceSlots + InfluenceIndex;
+					Surface.InfluenceBones[Slot] = RenderSection.BoneMap[View.GetBoneIndex(VertexIndex, InfluenceIndex)];
+					Surface.InfluenceWeights[Slot] = View.GetBoneWeight(VertexIndex, InfluenceIndex) / 65535.0f;
+				}
 			}
+		});
+
+		const TArray<FSurfaceTaskRange> IndexTasks = MakeSurfaceTaskRanges(
+			SurfacesNum,
+			[&](const int32 SurfaceIndex) { return OutSurfaces[SurfaceIndex].Indices.Num(); });
+
+		ParallelFor(IndexTasks.Num(), [&](const int32 TaskIndex)
+		{
+			const FSurfaceTaskRange& Task = IndexTasks[TaskIndex];
+			FPackedMeshSurface& Surface = OutSurfaces[Task.SurfaceIndex];
+			const FSkelMeshRenderSection& RenderSection = RenderSections[Sections[Task.SurfaceIndex]];
+
+			// Note: Subtracting the `BaseVertexIndex` to obtain the index relative
+			// on the surface.
+			View.CopyIndices(
+				RenderSection.BaseIndex + Task.Begin,
+				MakeArrayView(Surface.Indices.GetData() + Task.Begin, Task.End - Task.Begin),
+				RenderSection.BaseVertexIndex);
+		});
 
-			checkf(static_cast<int32>(RenderData.SkinWeightVertexBuffer.GetMaxBoneInfluences()) >= RenderSection.MaxBoneInfluences, TEXT("These two MUST be the same."));
+		return true;
+	}
 
-			Surface.BoneInfluences[i].SetNum(RenderSection.MaxBoneInfluences);
-			for (
-				int32 BoneInfluenceIndex = 0;
-				BoneInfluenceIndex < RenderSection.MaxBoneInfluences;
-				BoneInfluenceIndex += 1)
+	/// The sections of `View` that use one of `MaterialsFilter`, or all of them
+	/// when the filter is empty.
+	TArray<int32> FilterSectionsByMaterial(const FRuntimeSkeletalMeshView& View, TConstArrayView<int32> MaterialsFilter)
+	{
+		TArray<int32> Sections;
+		if (!View.IsValid())
+		{
+			return Sections;
+		}
+		const TConstArrayView<FSkelMeshRenderSection> RenderSections = View.GetSections();
+		for (int32 SectionIndex = 0; SectionIndex < RenderSections.Num(); SectionIndex += 1)
+		{
+			if (MaterialsFilter.Num() == 0 || MaterialsFilter.Contains(RenderSections[SectionIndex].MaterialIndex))
 			{
-				Surface.BoneInfluences[i][BoneInfluenceIndex].VertexIndex = i;
-				Surface.BoneInfluences[i][BoneInfluenceIndex].BoneIndex =
-					RenderSection.BoneMap[RenderData.SkinWeightVertexBuffer.GetBoneIndex(VertexIndex, BoneInfluenceIndex)];
-				Surface.BoneInfluences[i][BoneInfluenceIndex].Weight =
-					static_cast<float>(FMath::Clamp(RenderData.SkinWeightVertexBuffer.GetBoneWeight(VertexIndex, BoneInfluenceIndex) / 65535.0, 0.0, 1.0));
+				Sections.Add(SectionIndex);
 			}
 		}
+		return Sections;
+	}
+
+	void GetSurfacesMaterial(const USkeletalMesh* SkeletalMesh, TArray<UMaterialInterface*>& OutSurfacesMaterial)
+	{
+		OutSurfacesMaterial.Reset(SkeletalMesh->GetMaterials().Num());
+		for (const auto& Material : SkeletalMesh->GetMaterials())
+		{
+			OutSurfacesMaterial.Emplace(Material.MaterialInterface);
+		}
+	}
+}
+
+bool FRuntimeSkeletalMeshGenerator::DecomposeSkeletalMesh(
+	/// The `SkeletalMesh` to decompose
+	const USkeletalMesh* SkeletalMesh,
+	/// Out Surfaces.
+	TArray<FPackedMeshSurface>& OutSurfaces,
+	/// The vertex offsets for each surface, relative to the passed `SkeletalMesh`
+	TArray<int32>& OutSurfacesVertexOffsets,
+	/// The index offsets for each surface, relative to the passed `SkeletalMesh`
+	TArray<int32>& OutSurfacesIndexOffsets,
+	/// Out Materials used.
+	TArray<UMaterialInterface*>& OutSurfacesMaterial)
+{
+	return DecomposeSkeletalMeshLOD(
+		SkeletalMesh,
+		0,
+		OutSurfaces,
+		OutSurfacesVertexOffsets,
+		OutSurfacesIndexOffsets,
+		OutSurfacesMaterial);
+}
+
+bool FRuntimeSkeletalMeshGenerator::DecomposeSkeletalMeshLOD(
+	const USkeletalMesh* SkeletalMesh,
+	const int32 LODIndex,
+	TArray<FPackedMeshSurface>& OutSurfaces,
+	TArray<int32>& OutSurfacesVertexOffsets,
+	TArray<int32>& OutSurfacesIndexOffsets,
+	TArray<UMaterialInterface*>& OutSurfacesMaterial,
+	TConstArrayView<int32> SectionsFilter)
+{
+	RUNTIME_SKELETAL_MESH_PHASE(Decompose);
+	GeneratorStats.DecomposedMeshes += 1;
 
-		const uint32 IndexIndexOffset = RenderSection.BaseIndex;
-		const uint32 IndexCount = RenderSection.NumTriangles * 3;
+	OutSurfacesMaterial.Empty();
 
-		OutSurfacesIndexOffsets[SectionIndex] = IndexIndexOffset;
-		Surface.Indices.SetNum(IndexCount);
+	const FRuntimeSkeletalMeshView View(SkeletalMesh, LODIndex);
 
-		for (uint32 i = 0; i < IndexCount; i += 1)
+	TArray<int32> Sections;
+	if (SectionsFilter.Num() > 0)
+	{
+		Sections.Append(SectionsFilter.GetData(), SectionsFilter.Num());
+	}
+	else if (View.IsValid())
+	{
+		Sections.SetNumUninitialized(View.GetSections().Num());
+		for (int32 SectionIndex = 0; SectionIndex < Sections.Num(); SectionIndex += 1)
 		{
-			const uint32 Index = i + IndexIndexOffset;
-			// Note: Subtracting the `VertexIndexOffset` to obtain the index relative
-			// on the surface.
-			Surface.Indices[i] = IndexBuffer[Index] - VertexIndexOffset;
+			Sections[SectionIndex] = SectionIndex;
 		}
 	}
 
-	OutSurfacesMaterial.Reserve(SkeletalMesh->GetMaterials().Num());
-	for (const auto& Material : SkeletalMesh->GetMaterials())
+	if (!DecomposeLOD(View, Sections, OutSurfaces, OutSurfacesVertexOffsets, OutSurfacesIndexOffsets))
+	{
+		return false;
+	}
+
+	GetSurfacesMaterial(SkeletalMesh, OutSurfacesMaterial);
+	return true;
+}
+
+bool FRuntimeSkeletalMeshGenerator::DecomposeSkeletalMeshLODs(
+	const USkeletalMesh* SkeletalMesh,
+	TArray<FMeshLOD>& OutLODs,
+	TArray<UMaterialInterface*>& OutSurfacesMaterial,
+	TConstArrayView<int32> MaterialsFilter)
+{
+	RUNTIME_SKELETAL_MESH_PHASE(Decompose);
+	GeneratorStats.DecomposedMeshes += 1;
+
+	OutLODs.Empty();
+	OutSurfacesMaterial.Empty();
+
+	const FSkeletalMeshRenderData* RenderData = SkeletalMesh ? SkeletalMesh->GetResourceForRendering() : nullptr;
+	if (RenderData == nullptr || RenderData->LODRenderData.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The mesh has no render data to decompose."));
+		return false;
+	}
+
+	// The sections of each LOD are already extracted in parallel, so the LODs
+	// are processed one after the other.
+	OutLODs.SetNum(RenderData->LODRenderData.Num());
+	for (int32 LODIndex = 0; LODIndex < OutLODs.Num(); LODIndex += 1)
 	{
-		OutSurfacesMaterial.Emplace(Material.MaterialInterface);
+		const FRuntimeSkeletalMeshView View(RenderData->LODRenderData[LODIndex]);
+		TArray<int32> VertexOffsets;
+		TArray<int32> IndexOffsets;
+		if (!DecomposeLOD(View, FilterSectionsByMaterial(View, MaterialsFilter), OutLODs[LODIndex].Surfaces, VertexOffsets, IndexOffsets))
+		{
+			OutLODs.Empty();
+			return false;
+		}
+
+		if (const FSkeletalMeshLODInfo* LODInfo = SkeletalMesh->GetLODInfo(LODIndex))
+		{
+			OutLODs[LODIndex].ScreenSize = LODInfo->ScreenSize.Default;
+			OutLODs[LODIndex].LODHysteresis = LODInfo->LODHysteresis;
+		}
 	}
 
+	GetSurfacesMaterial(SkeletalMesh, OutSurfacesMaterial);
 	return true;
 }
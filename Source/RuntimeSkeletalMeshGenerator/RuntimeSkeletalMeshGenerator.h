@@ -17,6 +17,8 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Rendering/SkeletalMeshLODImporterData.h"
 #include "Rendering/SkeletalMeshRenderData.h"
+#include "Rendering/SkinWeightVertexBuffer.h"
+#include "StaticMeshResources.h"
 
 /**
  * Struct for BoneInfluences.
@@ -50,6 +52,286 @@ struct RUNTIMESKELETALMESHGENERATOR_API FMeshSurface
 	TArray<TArray<FRawBoneInfluence>> BoneInfluences{};
 };
 
+/**
+ * Packed version of `FMeshSurface`: the vertex data is stored in flat arrays,
+ * so the amount of allocations doesn't depend on the vertices count.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FPackedMeshSurface
+{
+	int32 MaterialIndex = 0;
+	/// The amount of UVs each vertex has.
+	int32 UVChannels = 0;
+	/// The amount of bone influences each vertex has.
+	int32 InfluenceSlots = 0;
+	TArray<uint32> Indices{};
+	TArray<FVector3f> Vertices{};
+	TArray<FVector3f> Tangents{};
+	TArray<FVector3f> Normals{};
+	/// `UVChannels` UVs for each vertex: `Uvs[VertexIndex * UVChannels + UVIndex]`.
+	TArray<FVector2f> Uvs{};
+	TArray<FColor> Colors{};
+	TArray<bool> FlipBinormalSigns{};
+	/// `InfluenceSlots` bones for each vertex:
+	/// `InfluenceBones[VertexIndex * InfluenceSlots + InfluenceIndex]`.
+	/// The unused slots have weight 0.
+	TArray<FBoneIndexType> InfluenceBones{};
+	/// The weight of each `InfluenceBones`, in the range 0.0 - 1.0.
+	TArray<float> InfluenceWeights{};
+
+	FPackedMeshSurface() = default;
+	explicit FPackedMeshSurface(const FMeshSurface& Surface);
+
+	/// Unpacks this surface into `OutSurface`.
+	void ToMeshSurface(FMeshSurface& OutSurface) const;
+
+	int32 NumVertices() const
+	{
+		return Vertices.Num();
+	}
+};
+
+/**
+ * The surfaces of a single LOD, used to generate a `USkeletalMesh` with many
+ * LODs.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FMeshLOD
+{
+	TArray<FPackedMeshSurface> Surfaces{};
+	/// The screen size, below which the next LOD is used.
+	float ScreenSize = 1.0;
+	float LODHysteresis = 0.02;
+};
+
+/**
+ * Optional processing applied while building a LOD.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshBuildOptions
+{
+	/// Pack the vertices, skin weights and indices with `ParallelFor`. Disable
+	/// it when many LODs are already built in parallel, so the workers are not
+	/// oversubscribed.
+	bool bParallelPack = true;
+
+	/// Reorder the triangles of each section for the post transform vertex
+	/// cache and to reduce the overdraw, then reorder the vertices in the order
+	/// they are fetched. It makes the build slower, and the rendering faster.
+	bool bOptimizeIndices = false;
+
+	/// Merge the vertices of each section that are equal within the following
+	/// tolerances: useful for the surfaces built from per face data.
+	bool bWeldVertices = false;
+	/// The max distance between two welded vertices.
+	float WeldPositionTolerance = 0.001f;
+	/// The max distance between the normals, and the tangents, of two welded
+	/// vertices.
+	float WeldNormalTolerance = 0.01f;
+	/// The max difference of each UV component of two welded vertices.
+	float WeldUVTolerance = 1.0f / 1024.0f;
+	/// The max difference of each bone weight (0.0 - 1.0) of two welded vertices.
+	float WeldWeightTolerance = 1.0f / 255.0f;
+
+	/// Build the tables of the vertices sharing the same position (within
+	/// `WeldPositionTolerance`) with other vertices, for the seams that stay
+	/// split. They are used by the skin cache to recompute the tangents.
+	bool bBuildDuplicatedVertices = false;
+
+	/// Store the UVs as 32 bits floats. When false they are stored as 16 bits
+	/// floats, which halves the UVs memory.
+	bool bUseFullPrecisionUVs = true;
+	/// Store the tangents with 16 bits per component, instead of 8 bits.
+	bool bUseHighPrecisionTangentBasis = false;
+	/// Store the bone weights with 16 bits, instead of 8 bits.
+	bool bUseHighPrecisionBoneWeights = false;
+
+	/// Sort the influences of each vertex by weight, keep at most
+	/// `MaxInfluencesPerVertex` of them, drop the ones below `MinBoneWeight`
+	/// and normalize the others, so their sum is exactly 1.
+	bool bSanitizeBoneWeights = false;
+	int32 MaxInfluencesPerVertex = MAX_TOTAL_INFLUENCES;
+	/// The weight (0.0 - 1.0) below which an influence is dropped.
+	float MinBoneWeight = 1.0f / 255.0f;
+
+	/// Merge the surfaces sharing a material in a single section, to reduce
+	/// the draw calls. The surfaces are moved so the ones with the same
+	/// material are contiguous: use `SurfaceVertexOffsets` and
+	/// `SurfaceIndexOffsets` to locate them.
+	/// A LOD with merged sections can't be updated with
+	/// `UpdateSkeletalMeshLODData`.
+	bool bMergeSectionsByMaterial = false;
+};
+
+/**
+ * Describes a render section of a generated LOD.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshSection
+{
+	/// The index of the `FMeshSurface` this section was generated from: the
+	/// first one, when the section merges more surfaces.
+	int32 SurfaceIndex = INDEX_NONE;
+	int32 MaterialIndex = 0;
+	uint32 BaseVertexIndex = 0;
+	uint32 NumVertices = 0;
+	uint32 BaseIndex = 0;
+	uint32 NumTriangles = 0;
+	/// The influence slots used by the section vertices.
+	int32 MaxBoneInfluences = 0;
+	/// The skeleton bones used by this section: the skin weights store the
+	/// index of this array.
+	TArray<FBoneIndexType> BoneMap{};
+	/// The section vertices at the same position of each vertex, indexed by
+	/// `DuplicatedVerticesIndex`. Both are empty when there are no seams.
+	TArray<uint32> DuplicatedVertices{};
+	TArray<FIndexLengthPair> DuplicatedVerticesIndex{};
+};
+
+/**
+ * The vertex streams of a LOD, encoded as the render buffers store them, so
+ * they are uploaded as they are. The layout depends on the precision flags of
+ * the `FRuntimeSkeletalMeshLODData` that contains them.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshVertexStreams
+{
+	TArray<FVector3f> Positions{};
+	/// `TangentX` and `TangentZ`, with the binormal sign in W, for each vertex:
+	/// `FPackedRGBA16N` when `bUseHighPrecisionTangentBasis`, `FPackedNormal`
+	/// otherwise.
+	TArray<uint8> Tangents{};
+	/// `UVCount` UVs for each vertex: `FVector2f` when `bUseFullPrecisionUVs`,
+	/// `FVector2DHalf` otherwise.
+	TArray<uint8> TexCoords{};
+	/// Empty when the LOD has no vertex colors.
+	TArray<FColor> Colors{};
+	/// `MaxBoneInfluences` section bone indices for each vertex, 16 bits when
+	/// `bUse16BitBoneIndex`, followed by as many weights, 16 bits when
+	/// `bUseHighPrecisionBoneWeights`.
+	TArray<uint8> SkinWeights{};
+
+	bool IsEmpty() const
+	{
+		return Positions.Num() == 0;
+	}
+};
+
+/**
+ * The CPU side buffers of a generated LOD, ready to be uploaded.
+ * Building this structure doesn't touch any `UObject`, so it can be done from
+ * any thread.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshLODData
+{
+	TArray<FStaticMeshBuildVertex> StaticVertices{};
+	TArray<uint32> Indices{};
+	TArray<FSkinWeightInfo> Weights{};
+	TArray<FRuntimeSkeletalMeshSection> Sections{};
+	/// The vertex offsets for each surface, relative to the generated LOD.
+	TArray<uint32> SurfaceVertexOffsets{};
+	/// The index offsets for each surface, relative to the generated LOD.
+	TArray<uint32> SurfaceIndexOffsets{};
+	/// The surfaces, in the order they are laid out in the buffers. Empty when
+	/// it's the surfaces order, which is the case unless the sections were
+	/// merged.
+	TArray<int32> SurfaceOrder{};
+	/// For each surface, the xxHash64 of the indices it was built from, so
+	/// `UpdateSkeletalMeshVertices` can tell when the topology changed. Empty
+	/// when the LOD was merged from other meshes.
+	TArray<uint64> SurfaceIndicesHashes{};
+	/// For each vertex, the index of the surface vertex it was built from.
+	/// Empty when the vertices map 1:1 to the surfaces vertices, which is the
+	/// case unless a section was split, welded or optimized.
+	TArray<uint32> SourceVertices{};
+	/// The vertex streams already encoded, e.g. copied from other meshes by
+	/// `BuildMergedSkeletalMeshLODData`: when set, they are uploaded instead of
+	/// `StaticVertices` and `Weights`, which are filled only in the editor.
+	/// Such a LOD can't be updated, build it again instead.
+	FRuntimeSkeletalMeshVertexStreams VertexStreams{};
+	FBox Bounds{ForceInit};
+	int32 UVCount = 0;
+	int32 MaxBoneInfluences = 0;
+	bool bUse16BitBoneIndex = false;
+	bool bHasVertexColors = false;
+	/// The vertex streams layout, see `FRuntimeSkeletalMeshBuildOptions`.
+	bool bUseFullPrecisionUVs = true;
+	bool bUseHighPrecisionTangentBasis = false;
+	bool bUseHighPrecisionBoneWeights = false;
+	/// True when some sections contain more surfaces.
+	bool bMergedSections = false;
+	/// The screen size, below which the next LOD is used.
+	float ScreenSize = 1.0;
+	float LODHysteresis = 0.02;
+
+#if WITH_EDITORONLY_DATA
+	/// The data used by the editor during reload time.
+	FSkeletalMeshImportData ImportedModelData{};
+#endif
+};
+
+/**
+ * The changes to apply to the surfaces of an already built LOD.
+ * The indices refer to the surfaces the LOD was built from.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FMeshSurfacesUpdate
+{
+	/// The surfaces to replace, by surface index.
+	TMap<int32, FPackedMeshSurface> Replace{};
+	/// The surfaces to remove. Like `TArray::RemoveAt`, the following surfaces
+	/// are shifted down.
+	TArray<int32> Remove{};
+	/// The surfaces to append, after the existing ones.
+	TArray<FPackedMeshSurface> Add{};
+};
+
+/**
+ * Where the generator spent time and memory, accumulated since the last
+ * `FRuntimeSkeletalMeshGenerator::ResetStats`.
+ * The same phases and counters are shown by `stat RuntimeSkeletalMeshGenerator`
+ * and in Unreal Insights.
+ */
+struct RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshGeneratorStats
+{
+	int64 BuiltLODs = 0;
+	int64 CommittedMeshes = 0;
+	int64 DecomposedMeshes = 0;
+
+	/// Build phases: these can run on any thread.
+	double CountSeconds = 0.0;
+	double PackSeconds = 0.0;
+	double IndicesSeconds = 0.0;
+	double BoneMapSeconds = 0.0;
+	double OptimizeSeconds = 0.0;
+	double WeldSeconds = 0.0;
+	/// Time spent to build the duplicated vertices tables.
+	double DuplicatedVerticesSeconds = 0.0;
+	double MergeSeconds = 0.0;
+	double MergeMeshesSeconds = 0.0;
+	/// Editor only.
+	double ImportDataSeconds = 0.0;
+
+	/// Commit phases: these run on the game thread.
+	double IndexBufferSeconds = 0.0;
+	double VertexBuffersSeconds = 0.0;
+	double SkinWeightsSeconds = 0.0;
+	double PostLoadSeconds = 0.0;
+
+	double DecomposeSeconds = 0.0;
+
+	/// The size of the built LODs.
+	int64 Vertices = 0;
+	int64 Indices = 0;
+	int64 Sections = 0;
+	/// The sum of the bones referenced by each section.
+	int64 SectionBones = 0;
+	/// The bytes allocated by the CPU side buffers.
+	int64 AllocatedBytes = 0;
+};
+
+/**
+ * Called on the game thread once the asynchronous generation is done.
+ */
+DECLARE_DELEGATE_OneParam(FOnRuntimeSkeletalMeshGenerated, bool /* bSuccess */);
+
+class FRuntimeSkeletalMeshCache;
+class FRuntimeSkeletalMeshPool;
+
 class FRuntimeSkeletalMeshGeneratorModule : public IModuleInterface
 {
 public: // ------------------------------------- IModuleInterface implementation
@@ -68,8 +350,258 @@ public: // ----------------------------------------------------------------- API
 		const TArray<FMeshSurface>& Surfaces,
 		const TArray<UMaterialInterface*>& SurfacesMaterial,
 		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Generate the `SkeletalMesh` for the given packed surfaces.
+	 */
+	static bool GenerateSkeletalMesh(
+		USkeletalMesh* SkeletalMesh,
+		const TArray<FPackedMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Generate the `SkeletalMesh` with one LOD for each element of `LODs`.
+	 * The LODs must be sorted from the most to the least detailed one, and all
+	 * of them share the same `SurfacesMaterial`.
+	 */
+	static bool GenerateSkeletalMesh(
+		USkeletalMesh* SkeletalMesh,
+		const TArray<FMeshLOD>& LODs,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Generate the `SkeletalMesh` for the given surfaces, without stalling the
+	 * calling thread.
+	 * The CPU side buffers are built on a worker thread, then the upload to the
+	 * `SkeletalMesh` is done on the game thread.
+	 * Must be called from the game thread. The `SkeletalMesh` and the
+	 * `SurfacesMaterial` must be kept alive until the generation is done: it
+	 * fails when any of them is destroyed meanwhile.
+	 */
+	static TFuture<bool> GenerateSkeletalMeshAsync(
+		USkeletalMesh* SkeletalMesh,
+		TArray<FMeshSurface> Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		FOnRuntimeSkeletalMeshGenerated OnGenerated = FOnRuntimeSkeletalMeshGenerated(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Packed surfaces version of `GenerateSkeletalMeshAsync`.
+	 */
+	static TFuture<bool> GenerateSkeletalMeshAsync(
+		USkeletalMesh* SkeletalMesh,
+		TArray<FPackedMeshSurface> Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		FOnRuntimeSkeletalMeshGenerated OnGenerated = FOnRuntimeSkeletalMeshGenerated(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Multi LOD version of `GenerateSkeletalMeshAsync`.
+	 */
+	static TFuture<bool> GenerateSkeletalMeshAsync(
+		USkeletalMesh* SkeletalMesh,
+		TArray<FMeshLOD> LODs,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		FOnRuntimeSkeletalMeshGenerated OnGenerated = FOnRuntimeSkeletalMeshGenerated(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Build the CPU side buffers for the given surfaces.
+	 * This function doesn't access any `UObject`, so it's safe to call it from
+	 * any thread.
+	 */
+	static bool BuildSkeletalMeshLODData(
+		const FReferenceSkeleton& RefSkeleton,
+		const TArray<FMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const TMap<FName, FTransform>& BoneTransformsOverride,
+		FRuntimeSkeletalMeshLODData& OutLODData,
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Packed surfaces version of `BuildSkeletalMeshLODData`.
+	 */
+	static bool BuildSkeletalMeshLODData(
+		const FReferenceSkeleton& RefSkeleton,
+		const TArray<FPackedMeshSurface>& Surfaces,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const TMap<FName, FTransform>& BoneTransformsOverride,
+		FRuntimeSkeletalMeshLODData& OutLODData,
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Apply `Update` to the already built `InOutLODData`: only the changed
+	 * surfaces are built, the buffers of the other surfaces are moved as they
+	 * are.
+	 * This function doesn't access any `UObject`, so it's safe to call it from
+	 * any thread.
+	 */
+	static bool UpdateSkeletalMeshLODData(
+		const FReferenceSkeleton& RefSkeleton,
+		FMeshSurfacesUpdate Update,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const TMap<FName, FTransform>& BoneTransformsOverride,
+		FRuntimeSkeletalMeshLODData& InOutLODData,
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Replace, remove or add some surfaces of a `SkeletalMesh` generated from
+	 * `InOutLODData`, without building the other surfaces again.
+	 * `InOutLODData` is updated, so it can be used for the next update.
+	 * The mesh is committed again with this LOD only, so it fails when the mesh
+	 * has more LODs: use `UpdateSkeletalMeshLODData` on each LOD and
+	 * `CommitSkeletalMesh` instead.
+	 * Must be called from the game thread.
+	 */
+	static bool UpdateSkeletalMeshSurfaces(
+		USkeletalMesh* SkeletalMesh,
+		FRuntimeSkeletalMeshLODData& InOutLODData,
+		FMeshSurfacesUpdate Update,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Update the positions and tangents of the LOD `LODIndex` of a `SkeletalMesh`
+	 * generated from `InOutLODData`, in place.
+	 * The `Surfaces` must have the same topology the LOD was built from: only
+	 * the vertices position, normal and tangent can change, and it fails when
+	 * the indices of a surface differ from the ones it was built from. This is
+	 * much faster than generating the mesh again, and no `UObject` is created.
+	 * The mesh bounds are updated, and the `Components` refresh theirs when a
+	 * vertex moves outside the previous bounds: pass the components using the
+	 * mesh, or they keep culling it with the old bounds.
+	 * Must be called from the game thread.
+	 */
+	static bool UpdateSkeletalMeshVertices(
+		USkeletalMesh* SkeletalMesh,
+		FRuntimeSkeletalMeshLODData& InOutLODData,
+		const TArray<FPackedMeshSurface>& Surfaces,
+		const int32 LODIndex = 0,
+		TConstArrayView<USkinnedMeshComponent*> Components = TConstArrayView<USkinnedMeshComponent*>());
+
+	/**
+	 * Upload the already built `LODs` to the `SkeletalMesh`, the first one is
+	 * the LOD 0.
+	 * Must be called from the game thread.
+	 */
+	static bool CommitSkeletalMesh(
+		USkeletalMesh* SkeletalMesh,
+		TConstArrayView<FRuntimeSkeletalMeshLODData> LODs,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false);
+
+	/**
+	 * Write the already built `LODs` to a versioned binary blob, that can be
+	 * loaded back with `DeserializeSkeletalMeshLODData` without building the
+	 * buffers again.
+	 * Note: The blob layout depends on the engine version and platform, so it's
+	 * meant to be used as a local cache.
+	 */
+	static void SerializeSkeletalMeshLODData(
+		TConstArrayView<FRuntimeSkeletalMeshLODData> LODs,
+		TArray<uint8>& OutData);
+
+	/**
+	 * Read the `LODs` written by `SerializeSkeletalMeshLODData`.
+	 * Returns false if the blob is invalid, was written by another version, or
+	 * doesn't match the skeleton.
+	 * This function doesn't access any `UObject`, so it's safe to call it from
+	 * any thread.
+	 */
+	static bool DeserializeSkeletalMeshLODData(
+		TConstArrayView<uint8> Data,
+		const FReferenceSkeleton& RefSkeleton,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const TMap<FName, FTransform>& BoneTransformsOverride,
+		TArray<FRuntimeSkeletalMeshLODData>& OutLODs);
+
+	/**
+	 * Save the already built `LODs` to the file `Filename`.
+	 */
+	static bool SaveSkeletalMeshLODData(
+		TConstArrayView<FRuntimeSkeletalMeshLODData> LODs,
+		const FString& Filename);
+
+	/**
+	 * Load the `LODs` saved by `SaveSkeletalMeshLODData`, the file is memory
+	 * mapped when the platform supports it.
+	 * This function doesn't access any `UObject`, so it's safe to call it from
+	 * any thread.
+	 */
+	static bool LoadSkeletalMeshLODData(
+		const FString& Filename,
+		const FReferenceSkeleton& RefSkeleton,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const TMap<FName, FTransform>& BoneTransformsOverride,
+		TArray<FRuntimeSkeletalMeshLODData>& OutLODs);
+
+	/**
+	 * Generate the `SkeletalMesh` from the file saved by
+	 * `SaveSkeletalMeshLODData`.
+	 */
+	static bool GenerateSkeletalMeshFromFile(
+		USkeletalMesh* SkeletalMesh,
+		const FString& Filename,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess = false,
 		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>());
 
+	/**
+	 * Build the LODs of a mesh combining the `SourceMeshes`, copying their
+	 * render buffers: each render section of the sources becomes a surface.
+	 * The vertex streams of a section are copied as they are when the source
+	 * stores them in the format of the merged mesh, which is chosen by the
+	 * precision flags of `BuildOptions` (the other options are not used): the
+	 * streams in another format are converted.
+	 * The bones are remapped by name to `RefSkeleton`, the bones missing in it
+	 * are replaced by their first ancestor that exists.
+	 * The materials of the sources are appended to `OutSurfacesMaterial`.
+	 * Only the LODs all the sources have are built, with the screen size and
+	 * hysteresis of the first source, and the sources must keep their vertices
+	 * on the CPU (`bAllowCPUAccess`).
+	 * Must be called from the game thread.
+	 */
+	static bool BuildMergedSkeletalMeshLODData(
+		const FReferenceSkeleton& RefSkeleton,
+		TConstArrayView<const USkeletalMesh*> SourceMeshes,
+		TArray<FRuntimeSkeletalMeshLODData>& OutLODs,
+		TArray<UMaterialInterface*>& OutSurfacesMaterial,
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Generate the `SkeletalMesh` combining the `SourceMeshes`, without
+	 * decomposing them: see `BuildMergedSkeletalMeshLODData`.
+	 */
+	static bool MergeSkeletalMeshes(
+		USkeletalMesh* SkeletalMesh,
+		TConstArrayView<const USkeletalMesh*> SourceMeshes,
+		const bool bNeedCPUAccess = false,
+		const FRuntimeSkeletalMeshBuildOptions& BuildOptions = FRuntimeSkeletalMeshBuildOptions());
+
+	/**
+	 * Returns the time and memory spent by the generator since the last
+	 * `ResetStats`.
+	 */
+	static FRuntimeSkeletalMeshGeneratorStats GetStats();
+
+	static void ResetStats();
+
 	/**
 	 * Generate the `SkeletalMeshComponent` for the given surfaces, and add the
 	 * component to the `Actor`.
@@ -80,7 +612,13 @@ public: // ----------------------------------------------------------------- API
 		const TArray<FMeshSurface>& Surfaces,
 		const TArray<UMaterialInterface*>& SurfacesMaterial,
 		const bool bNeedCPUAccess = false,
-		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>());
+		const TMap<FName, FTransform>& BoneTransformsOverride = TMap<FName, FTransform>(),
+		/// When set, the `USkeletalMesh` is shared with the other components
+		/// generated with the same parameters.
+		FRuntimeSkeletalMeshCache* Cache = nullptr,
+		/// When set, the component, and the `USkeletalMesh` when it's not taken
+		/// from the `Cache`, are recycled from this pool.
+		FRuntimeSkeletalMeshPool* Pool = nullptr);
 
 	/**
 	 * Update an existing the `SkeletalMeshComponent` for the given surfaces
@@ -92,7 +630,13 @@ public: // ----------------------------------------------------------------- API
 		const TArray<FMeshSurface>& Surfaces,
 		const TArray<UMaterialInterface*>& SurfacesMaterial,
 		const bool bNeedCPUAccess = false,
-		const TMap<FName, FTransform>& BoneTransformOverrides = TMap<FName, FTransform>());
+		const TMap<FName, FTransform>& BoneTransformOverrides = TMap<FName, FTransform>(),
+		/// When set, the `USkeletalMesh` is shared with the other components
+		/// generated with the same parameters.
+		FRuntimeSkeletalMeshCache* Cache = nullptr,
+		/// When set, the `USkeletalMesh` is taken from this pool when it's not
+		/// taken from the `Cache`, and the previous one is given back to it.
+		FRuntimeSkeletalMeshPool* Pool = nullptr);
 
 	/**
 	 * Decompose the `USkeletalMesh` in `Surfaces`.
@@ -108,4 +652,69 @@ public: // ----------------------------------------------------------------- API
 		TArray<int32>& OutSurfacesIndexOffsets,
 		/// Out Materials used.
 		TArray<UMaterialInterface*>& OutSurfacesMaterial);
+
+	/**
+	 * Decompose the LOD 0 of the `USkeletalMesh` in packed `Surfaces`.
+	 */
+	static bool DecomposeSkeletalMesh(
+		/// The `SkeletalMesh` to decompose
+		const USkeletalMesh* SkeletalMesh,
+		/// Out Surfaces.
+		TArray<FPackedMeshSurface>& OutSurfaces,
+		/// The vertex offsets for each surface, relative to the passed `SkeletalMesh`
+		TArray<int32>& OutSurfacesVertexOffsets,
+		/// The index offsets for each surface, relative to the passed `SkeletalMesh`
+		TArray<int32>& OutSurfacesIndexOffsets,
+		/// Out Materials used.
+		TArray<UMaterialInterface*>& OutSurfacesMaterial);
+
+	/**
+	 * Decompose a LOD of the `USkeletalMesh` in packed `Surfaces`, one for each
+	 * extracted section. The sections are extracted in parallel, straight from
+	 * the render buffers: the mesh must keep them on the CPU.
+	 */
+	static bool DecomposeSkeletalMeshLOD(
+		/// The `SkeletalMesh` to decompose
+		const USkeletalMesh* SkeletalMesh,
+		/// The LOD to decompose.
+		const int32 LODIndex,
+		/// Out Surfaces.
+		TArray<FPackedMeshSurface>& OutSurfaces,
+		/// The vertex offsets for each surface, relative to the passed `SkeletalMesh`
+		TArray<int32>& OutSurfacesVertexOffsets,
+		/// The index offsets for each surface, relative to the passed `SkeletalMesh`
+		TArray<int32>& OutSurfacesIndexOffsets,
+		/// Out Materials used.
+		TArray<UMaterialInterface*>& OutSurfacesMaterial,
+		/// The sections to extract, in this order. All of them when empty.
+		TConstArrayView<int32> SectionsFilter = {});
+
+	/**
+	 * Decompose all the LODs of the `USkeletalMesh`, with their screen sizes:
+	 * the result can be passed to `GenerateSkeletalMesh` as is.
+	 */
+	static bool DecomposeSkeletalMeshLODs(
+		/// The `SkeletalMesh` to decompose
+		const USkeletalMesh* SkeletalMesh,
+		/// Out LODs.
+		TArray<FMeshLOD>& OutLODs,
+		/// Out Materials used.
+		TArray<UMaterialInterface*>& OutSurfacesMaterial,
+		/// Extract only the sections using these material indices, so a single
+		/// piece can be extracted from every LOD. All of them when empty.
+		TConstArrayView<int32> MaterialsFilter = {});
+
+private:
+	static TFuture<bool> GenerateSkeletalMeshAsync_Internal(
+		USkeletalMesh* SkeletalMesh,
+		TUniqueFunction<bool(const FReferenceSkeleton&, TArray<FRuntimeSkeletalMeshLODData>&)> BuildLODs,
+		const TArray<UMaterialInterface*>& SurfacesMaterial,
+		const bool bNeedCPUAccess,
+		FOnRuntimeSkeletalMeshGenerated OnGenerated);
+
+	static void CommitLOD(
+		USkeletalMesh* SkeletalMesh,
+		const int32 LODIndex,
+		const FRuntimeSkeletalMeshLODData& LODData,
+		const bool bNeedCPUAccess);
 };
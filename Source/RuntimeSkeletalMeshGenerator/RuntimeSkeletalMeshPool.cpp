@@ -0,0 +1,165 @@
+#include "RuntimeSkeletalMeshPool.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "GameFramework/Actor.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr ERenameFlags PoolRenameFlags = REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional;
+}
+
+FRuntimeSkeletalMeshPool::FRuntimeSkeletalMeshPool(const int32 InMaxMeshes, const int32 InMaxComponents)
+	: MaxMeshes(InMaxMeshes)
+	, MaxComponents(InMaxComponents)
+{
+}
+
+USkeletalMesh* FRuntimeSkeletalMeshPool::AcquireSkeletalMesh()
+{
+	check(IsInGameThread());
+
+	USkeletalMesh* SkeletalMesh = nullptr;
+	for (int32 I = 0; I < FreeMeshes.Num(); I += 1)
+	{
+		if (FreeMeshes[I].ReleaseFence->IsFenceComplete())
+		{
+			SkeletalMesh = FreeMeshes[I].SkeletalMesh;
+			FreeMeshes.RemoveAt(I);
+			break;
+		}
+	}
+
+	if (SkeletalMesh)
+	{
+		// The rendering thread doesn't use the old render data anymore: drop it
+		// now, so the commit doesn't have to wait for it.
+		SkeletalMesh->SetResourceForRendering(TUniquePtr<FSkeletalMeshRenderData>());
+	}
+	else
+	{
+		// Note: we do not pass anything so the skeletal mesh is transient and
+		// destroyed when the play session end.
+		SkeletalMesh = NewObject<USkeletalMesh>();
+	}
+
+	AcquiredMeshes.Add(FObjectKey(SkeletalMesh));
+	return SkeletalMesh;
+}
+
+bool FRuntimeSkeletalMeshPool::ReleaseSkeletalMesh(USkeletalMesh* SkeletalMesh)
+{
+	check(IsInGameThread());
+
+	if (!SkeletalMesh || AcquiredMeshes.Remove(FObjectKey(SkeletalMesh)) == 0)
+	{
+		return false;
+	}
+
+	if (FreeMeshes.Num() >= MaxMeshes)
+	{
+		// The pool is full: the GC collects it.
+		return true;
+	}
+
+	FFreeMesh& FreeMesh = FreeMeshes.AddDefaulted_GetRef();
+	FreeMesh.SkeletalMesh = SkeletalMesh;
+	FreeMesh.ReleaseFence = MakeUnique<FRenderCommandFence>();
+	if (SkeletalMesh->GetResourceForRendering() != nullptr)
+	{
+		SkeletalMesh->ReleaseResources();
+	}
+	FreeMesh.ReleaseFence->BeginFence();
+	return true;
+}
+
+USkeletalMeshComponent* FRuntimeSkeletalMeshPool::AcquireComponent(AActor* Actor)
+{
+	check(IsInGameThread());
+
+	if (FreeComponents.Num() == 0)
+	{
+		return NewObject<USkeletalMeshComponent>(
+			Actor,
+			USkeletalMeshComponent::StaticClass());
+	}
+
+	USkeletalMeshComponent* SkeletalMeshComponent = FreeComponents.Pop(false);
+	SkeletalMeshComponent->Rename(nullptr, Actor, PoolRenameFlags);
+	return SkeletalMeshComponent;
+}
+
+void FRuntimeSkeletalMeshPool::ReleaseComponent(USkeletalMeshComponent* SkeletalMeshComponent)
+{
+	check(IsInGameThread());
+
+	if (!SkeletalMeshComponent)
+	{
+		return;
+	}
+
+	USkeletalMesh* SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset();
+	SkeletalMeshComponent->SetSkeletalMesh(nullptr);
+	if (SkeletalMeshComponent->GetCPUSkinningEnabled())
+	{
+		SkeletalMeshComponent->SetCPUSkinningEnabled(false);
+	}
+
+	if (AActor* Actor = SkeletalMeshComponent->GetOwner())
+	{
+		Actor->RemoveInstanceComponent(SkeletalMeshComponent);
+	}
+	if (SkeletalMeshComponent->IsRegistered())
+	{
+		SkeletalMeshComponent->UnregisterComponent();
+	}
+	SkeletalMeshComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	SkeletalMeshComponent->SetRelativeTransform(FTransform::Identity);
+	SkeletalMeshComponent->EmptyOverrideMaterials();
+
+	ReleaseSkeletalMesh(SkeletalMesh);
+
+	if (FreeComponents.Num() >= MaxComponents)
+	{
+		SkeletalMeshComponent->DestroyComponent();
+		return;
+	}
+
+	// The component must not keep its actor alive while it waits in the pool.
+	SkeletalMeshComponent->Rename(nullptr, GetTransientPackage(), PoolRenameFlags);
+	FreeComponents.Add(SkeletalMeshComponent);
+}
+
+void FRuntimeSkeletalMeshPool::Empty()
+{
+	check(IsInGameThread());
+
+	FreeMeshes.Empty();
+	FreeComponents.Empty();
+}
+
+int32 FRuntimeSkeletalMeshPool::NumFreeMeshes() const
+{
+	return FreeMeshes.Num();
+}
+
+int32 FRuntimeSkeletalMeshPool::NumFreeComponents() const
+{
+	return FreeComponents.Num();
+}
+
+void FRuntimeSkeletalMeshPool::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FFreeMesh& FreeMesh : FreeMeshes)
+	{
+		Collector.AddReferencedObject(FreeMesh.SkeletalMesh);
+	}
+	Collector.AddReferencedObjects(FreeComponents);
+}
+
+FString FRuntimeSkeletalMeshPool::GetReferencerName() const
+{
+	return TEXT("FRuntimeSkeletalMeshPool");
+}
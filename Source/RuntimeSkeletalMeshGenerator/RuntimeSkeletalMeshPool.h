@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderCommandFence.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+/// Pool of `USkeletalMesh` and `USkeletalMeshComponent`, so the meshes of the
+/// characters that respawn or change clothes are recycled instead of being
+/// allocated each time and collected by the GC later.
+///
+/// A released mesh is reused only once the rendering thread has released its
+/// resources, so committing the new LODs never flushes the rendering thread.
+/// The pool keeps the released objects alive: up to `MaxMeshes` meshes and
+/// `MaxComponents` components, the others are left to the GC.
+/// Note: This class must be used from the game thread.
+class RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshPool : public FGCObject
+{
+	struct FFreeMesh
+	{
+		TObjectPtr<USkeletalMesh> SkeletalMesh;
+		/// Signaled once the rendering thread released the mesh resources.
+		TUniquePtr<FRenderCommandFence> ReleaseFence;
+	};
+
+	TArray<FFreeMesh> FreeMeshes;
+	TArray<TObjectPtr<USkeletalMeshComponent>> FreeComponents;
+	/// The meshes created by this pool, that are in use.
+	TSet<FObjectKey> AcquiredMeshes;
+	int32 MaxMeshes;
+	int32 MaxComponents;
+
+public:
+	explicit FRuntimeSkeletalMeshPool(const int32 InMaxMeshes = 64, const int32 InMaxComponents = 64);
+
+	/// Returns a released `USkeletalMesh`, or a new one when none is ready: it
+	/// has no LODs, generate it with `FRuntimeSkeletalMeshGenerator`.
+	USkeletalMesh* AcquireSkeletalMesh();
+
+	/// Gives back a mesh returned by `AcquireSkeletalMesh`, that nothing uses
+	/// anymore. Returns false, and does nothing, if the mesh was not created
+	/// by this pool (e.g. it comes from a `FRuntimeSkeletalMeshCache`).
+	bool ReleaseSkeletalMesh(USkeletalMesh* SkeletalMesh);
+
+	/// Returns an unregistered component owned by `Actor`: attach it and
+	/// register it as a newly created one.
+	USkeletalMeshComponent* AcquireComponent(AActor* Actor);
+
+	/// Unregisters the component, detaches it from its actor and keeps it for
+	/// a later `AcquireComponent`. Its mesh is released too, if it comes from
+	/// this pool.
+	void ReleaseComponent(USkeletalMeshComponent* SkeletalMeshComponent);
+
+	/// Drops all the released objects, the GC collects them.
+	void Empty();
+
+	int32 NumFreeMeshes() const;
+
+	int32 NumFreeComponents() const;
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+};
@@ -0,0 +1,64 @@
+#include "RuntimeSkeletalMeshView.h"
+
+#include "Engine/SkeletalMesh.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+
+FRuntimeSkeletalMeshView::FRuntimeSkeletalMeshView(const FSkeletalMeshLODRenderData& InLODRenderData)
+	: LODRenderData(&InLODRenderData)
+{
+	const FStaticMeshVertexBuffers& VertexBuffers = InLODRenderData.StaticVertexBuffers;
+
+	VerticesNum = VertexBuffers.PositionVertexBuffer.GetNumVertices();
+	bHighPrecisionTangents = VertexBuffers.StaticMeshVertexBuffer.GetUseHighPrecisionTangentBasis();
+	TangentStride = bHighPrecisionTangents ? sizeof(FPackedRGBA16N) * 2 : sizeof(FPackedNormal) * 2;
+	TexCoordsNum = VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords();
+	bFullPrecisionUVs = VertexBuffers.StaticMeshVertexBuffer.GetUseFullPrecisionUVs();
+	TexCoordStride = TexCoordsNum * (bFullPrecisionUVs ? sizeof(FVector2f) : sizeof(FVector2DHalf));
+
+	// Without CPU access the buffers free their data once uploaded: the
+	// pointers are left null, so the view is not valid.
+	if (VertexBuffers.PositionVertexBuffer.GetAllowCPUAccess() && VertexBuffers.StaticMeshVertexBuffer.GetAllowCPUAccess())
+	{
+		Positions = static_cast<const FVector3f*>(VertexBuffers.PositionVertexBuffer.GetVertexData());
+		Tangents = static_cast<const uint8*>(VertexBuffers.StaticMeshVertexBuffer.GetTangentData());
+		TexCoords = static_cast<const uint8*>(VertexBuffers.StaticMeshVertexBuffer.GetTexCoordData());
+
+		if (VertexBuffers.ColorVertexBuffer.GetNumVertices() == VerticesNum)
+		{
+			Colors = static_cast<const FColor*>(VertexBuffers.ColorVertexBuffer.GetVertexData());
+		}
+
+		// The index buffer interface is not const, but it's only read.
+		FRawStaticIndexBuffer16or32Interface* IndexBuffer = const_cast<FRawStaticIndexBuffer16or32Interface*>(InLODRenderData.MultiSizeIndexContainer.GetIndexBuffer());
+		if (IndexBuffer != nullptr && IndexBuffer->Num() > 0)
+		{
+			IndicesNum = IndexBuffer->Num();
+			IndexSize = InLODRenderData.MultiSizeIndexContainer.GetDataTypeSize();
+			Indices = static_cast<const uint8*>(IndexBuffer->GetPointerTo(0));
+		}
+	}
+
+	// With a constant amount of influences, the weights of each vertex are the
+	// bone indices followed by the bone weights; otherwise the weight buffer
+	// accessors are used.
+	const FSkinWeightVertexBuffer& SkinWeights = InLODRenderData.SkinWeightVertexBuffer;
+	MaxBoneInfluences = SkinWeights.GetMaxBoneInfluences();
+	bSkinWeightsCPUAccess = SkinWeights.GetNeedsCPUAccess();
+	const FSkinWeightDataVertexBuffer* WeightsBuffer = SkinWeights.GetDataVertexBuffer();
+	if (bSkinWeightsCPUAccess && !SkinWeights.GetVariableBonesPerVertex() && WeightsBuffer != nullptr)
+	{
+		BoneIndexSize = WeightsBuffer->GetBoneIndexByteSize();
+		BoneWeightSize = WeightsBuffer->GetBoneWeightByteSize();
+		WeightStride = WeightsBuffer->GetConstantInfluencesVertexStride();
+		Weights = WeightsBuffer->GetWeightData();
+	}
+}
+
+FRuntimeSkeletalMeshView::FRuntimeSkeletalMeshView(const USkeletalMesh* SkeletalMesh, const int32 LODIndex)
+{
+	const FSkeletalMeshRenderData* RenderData = SkeletalMesh ? SkeletalMesh->GetResourceForRendering() : nullptr;
+	if (RenderData != nullptr && RenderData->LODRenderData.IsValidIndex(LODIndex))
+	{
+		*this = FRuntimeSkeletalMeshView(RenderData->LODRenderData[LODIndex]);
+	}
+}
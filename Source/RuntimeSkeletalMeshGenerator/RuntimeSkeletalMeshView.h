@@ -0,0 +1,225 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/SkeletalMeshLODRenderData.h"
+
+class USkeletalMesh;
+
+/// A read only view over the render buffers of a `USkeletalMesh` LOD.
+/// Nothing is copied or allocated: the accessors decode the elements straight
+/// from the CPU copy of the buffers, so tools (picking, attachment, bounds)
+/// can iterate all the vertices cheaply. Use `DecomposeSkeletalMesh` instead
+/// when the surfaces must be modified.
+///
+/// The view is valid as long as the render data of the mesh is, and the mesh
+/// must keep its buffers on the CPU (`bAllowCPUAccess`): check `IsValid`.
+class RUNTIMESKELETALMESHGENERATOR_API FRuntimeSkeletalMeshView
+{
+	const FSkeletalMeshLODRenderData* LODRenderData = nullptr;
+	const FVector3f* Positions = nullptr;
+	const uint8* Tangents = nullptr;
+	const uint8* TexCoords = nullptr;
+	const FColor* Colors = nullptr;
+	const uint8* Indices = nullptr;
+	/// The skin weights, when each vertex has the same amount of influences.
+	const uint8* Weights = nullptr;
+	uint32 VerticesNum = 0;
+	uint32 IndicesNum = 0;
+	uint32 TexCoordsNum = 0;
+	uint32 TangentStride = 0;
+	uint32 TexCoordStride = 0;
+	uint32 IndexSize = 0;
+	uint32 WeightStride = 0;
+	uint32 BoneIndexSize = 0;
+	uint32 BoneWeightSize = 0;
+	uint32 MaxBoneInfluences = 0;
+	bool bHighPrecisionTangents = false;
+	bool bFullPrecisionUVs = false;
+	/// True when the skin weights are kept on the CPU, so they can be read
+	/// even when `Weights` is null.
+	bool bSkinWeightsCPUAccess = false;
+
+public:
+	FRuntimeSkeletalMeshView() = default;
+	explicit FRuntimeSkeletalMeshView(const FSkeletalMeshLODRenderData& InLODRenderData);
+	explicit FRuntimeSkeletalMeshView(const USkeletalMesh* SkeletalMesh, const int32 LODIndex = 0);
+
+	/// True when the buffers are available on the CPU.
+	bool IsValid() const
+	{
+		return Positions != nullptr && Tangents != nullptr && Indices != nullptr
+			&& (TexCoords != nullptr || TexCoordsNum == 0)
+			&& bSkinWeightsCPUAccess;
+	}
+
+	uint32 NumVertices() const { return VerticesNum; }
+	uint32 NumIndices() const { return IndicesNum; }
+	uint32 NumTexCoords() const { return TexCoordsNum; }
+	uint32 NumBoneInfluences() const { return MaxBoneInfluences; }
+	bool HasColors() const { return Colors != nullptr; }
+	bool HasHighPrecisionTangents() const { return bHighPrecisionTangents; }
+	bool HasFullPrecisionUVs() const { return bFullPrecisionUVs; }
+	/// The bytes of each bone index and weight of the skin weights: 0 when the
+	/// vertices don't have the same amount of influences.
+	uint32 GetBoneIndexSize() const { return Weights != nullptr ? BoneIndexSize : 0; }
+	uint32 GetBoneWeightSize() const { return Weights != nullptr ? BoneWeightSize : 0; }
+
+	TConstArrayView<FSkelMeshRenderSection> GetSections() const
+	{
+		return LODRenderData->RenderSections;
+	}
+
+	/// The positions of the whole LOD: they are tightly packed.
+	TConstArrayView<FVector3f> GetPositions() const
+	{
+		return TConstArrayView<FVector3f>(Positions, VerticesNum);
+	}
+
+	/// The positions of the vertices of a section.
+	TConstArrayView<FVector3f> GetSectionPositions(const int32 SectionIndex) const
+	{
+		const FSkelMeshRenderSection& Section = LODRenderData->RenderSections[SectionIndex];
+		return TConstArrayView<FVector3f>(Positions + Section.BaseVertexIndex, Section.NumVertices);
+	}
+
+	/// The encoded tangents of the vertices of a section, as stored by the
+	/// render buffer: see `FRuntimeSkeletalMeshVertexStreams::Tangents`.
+	TConstArrayView<uint8> GetSectionTangentData(const int32 SectionIndex) const
+	{
+		const FSkelMeshRenderSection& Section = LODRenderData->RenderSections[SectionIndex];
+		return TConstArrayView<uint8>(Tangents + Section.BaseVertexIndex * TangentStride, Section.NumVertices * TangentStride);
+	}
+
+	/// The encoded UVs of the vertices of a section, as stored by the render
+	/// buffer: see `FRuntimeSkeletalMeshVertexStreams::TexCoords`.
+	TConstArrayView<uint8> GetSectionTexCoordData(const int32 SectionIndex) const
+	{
+		const FSkelMeshRenderSection& Section = LODRenderData->RenderSections[SectionIndex];
+		return TexCoords != nullptr
+			? TConstArrayView<uint8>(TexCoords + Section.BaseVertexIndex * TexCoordStride, Section.NumVertices * TexCoordStride)
+			: TConstArrayView<uint8>();
+	}
+
+	/// Empty when the mesh has no vertex colors.
+	TConstArrayView<FColor> GetSectionColors(const int32 SectionIndex) const
+	{
+		const FSkelMeshRenderSection& Section = LODRenderData->RenderSections[SectionIndex];
+		return Colors != nullptr
+			? TConstArrayView<FColor>(Colors + Section.BaseVertexIndex, Section.NumVertices)
+			: TConstArrayView<FColor>();
+	}
+
+	/// The encoded skin weights of the vertices of a section, as stored by the
+	/// render buffer: see `FRuntimeSkeletalMeshVertexStreams::SkinWeights`.
+	/// Empty when the vertices don't have the same amount of influences.
+	TConstArrayView<uint8> GetSectionWeightData(const int32 SectionIndex) const
+	{
+		const FSkelMeshRenderSection& Section = LODRenderData->RenderSections[SectionIndex];
+		return Weights != nullptr
+			? TConstArrayView<uint8>(Weights + Section.BaseVertexIndex * WeightStride, Section.NumVertices * WeightStride)
+			: TConstArrayView<uint8>();
+	}
+
+	const FVector3f& GetPosition(const uint32 VertexIndex) const
+	{
+		checkSlow(VertexIndex < VerticesNum);
+		return Positions[VertexIndex];
+	}
+
+	FVector3f GetTangentX(const uint32 VertexIndex) const
+	{
+		return DecodeTangent(VertexIndex, 0).ToFVector3f();
+	}
+
+	FVector3f GetTangentY(const uint32 VertexIndex) const
+	{
+		const FVector4f TangentZ = DecodeTangent(VertexIndex, 1);
+		return FVector3f::CrossProduct(FVector3f(TangentZ), GetTangentX(VertexIndex)) * TangentZ.W;
+	}
+
+	FVector3f GetTangentZ(const uint32 VertexIndex) const
+	{
+		return DecodeTangent(VertexIndex, 1).ToFVector3f();
+	}
+
+	FVector2f GetUV(const uint32 VertexIndex, const uint32 UVIndex) const
+	{
+		checkSlow(VertexIndex < VerticesNum && UVIndex < TexCoordsNum);
+		const uint8* Data = TexCoords + VertexIndex * TexCoordStride;
+		return bFullPrecisionUVs
+			? reinterpret_cast<const FVector2f*>(Data)[UVIndex]
+			: FVector2f(reinterpret_cast<const FVector2DHalf*>(Data)[UVIndex]);
+	}
+
+	/// Returns white when the mesh has no vertex colors.
+	FColor GetColor(const uint32 VertexIndex) const
+	{
+		return Colors != nullptr ? Colors[VertexIndex] : FColor::White;
+	}
+
+	/// The index `Index` of the LOD index buffer.
+	uint32 GetIndex(const uint32 Index) const
+	{
+		checkSlow(Index < IndicesNum);
+		return IndexSize == sizeof(uint16)
+			? reinterpret_cast<const uint16*>(Indices)[Index]
+			: reinterpret_cast<const uint32*>(Indices)[Index];
+	}
+
+	/// Copies `OutIndices.Num()` indices, starting from `FirstIndex`, subtracting
+	/// `VertexOffset` from each: the index size is checked once for the whole range.
+	void CopyIndices(const uint32 FirstIndex, TArrayView<uint32> OutIndices, const uint32 VertexOffset = 0) const
+	{
+		checkSlow(FirstIndex + OutIndices.Num() <= IndicesNum);
+		if (IndexSize == sizeof(uint16))
+		{
+			const uint16* Source = reinterpret_cast<const uint16*>(Indices) + FirstIndex;
+			for (int32 I = 0; I < OutIndices.Num(); I += 1)
+			{
+				OutIndices[I] = Source[I] - VertexOffset;
+			}
+		}
+		else
+		{
+			const uint32* Source = reinterpret_cast<const uint32*>(Indices) + FirstIndex;
+			for (int32 I = 0; I < OutIndices.Num(); I += 1)
+			{
+				OutIndices[I] = Source[I] - VertexOffset;
+			}
+		}
+	}
+
+	/// The section bone index of the influence: use the section `BoneMap` to get
+	/// the skeleton bone.
+	uint32 GetBoneIndex(const uint32 VertexIndex, const uint32 InfluenceIndex) const
+	{
+		if (Weights == nullptr)
+		{
+			return LODRenderData->SkinWeightVertexBuffer.GetBoneIndex(VertexIndex, InfluenceIndex);
+		}
+		const uint8* Data = Weights + VertexIndex * WeightStride + InfluenceIndex * BoneIndexSize;
+		return BoneIndexSize == sizeof(uint16) ? *reinterpret_cast<const uint16*>(Data) : *Data;
+	}
+
+	/// The influence weight, in the 0 - 65535 range.
+	uint16 GetBoneWeight(const uint32 VertexIndex, const uint32 InfluenceIndex) const
+	{
+		if (Weights == nullptr)
+		{
+			return LODRenderData->SkinWeightVertexBuffer.GetBoneWeight(VertexIndex, InfluenceIndex);
+		}
+		const uint8* Data = Weights + VertexIndex * WeightStride + MaxBoneInfluences * BoneIndexSize + InfluenceIndex * BoneWeightSize;
+		return BoneWeightSize == sizeof(uint16) ? *reinterpret_cast<const uint16*>(Data) : uint16(*Data) * 257;
+	}
+
+	/// Decodes the `TangentX` (0) or the `TangentZ` (1), with the binormal sign
+	/// in W.
+	FVector4f DecodeTangent(const uint32 VertexIndex, const uint32 Tangent) const
+	{
+		checkSlow(VertexIndex < VerticesNum);
+		const uint8* Data = Tangents + VertexIndex * TangentStride;
+		return bHighPrecisionTangents
+			? reinterpret_cast<const FPackedRGBA16N*>(Data)[Tangent].ToFVector4f()
+			: reinterpret_cast<const FPackedNormal*>(Data)[Tangent].ToFVector4f();
+	}
+};